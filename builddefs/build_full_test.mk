@@ -34,3 +34,5 @@ $(TEST)_DEFS := $(TMK_COMMON_DEFS) $(OPT_DEFS)
 $(TEST)_CONFIG := $(TEST_PATH)/config.h
 
 VPATH += $(TOP_DIR)/tests/test_common
+# For features that include their config.h directly
+VPATH += $(TOP_DIR)/$(TEST_PATH)
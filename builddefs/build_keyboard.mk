@@ -106,8 +106,12 @@ MAIN_KEYMAP_PATH_3 := $(KEYBOARD_PATH_3)/keymaps/$(KEYMAP)
 MAIN_KEYMAP_PATH_4 := $(KEYBOARD_PATH_4)/keymaps/$(KEYMAP)
 MAIN_KEYMAP_PATH_5 := $(KEYBOARD_PATH_5)/keymaps/$(KEYMAP)
 
-# Pull in rules from info.json
-INFO_RULES_MK = $(shell $(QMK_BIN) generate-rules-mk --quiet --escape --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/info_rules.mk)
+# Pull in rules from info.json. The headers and sources derived from info.json are written by the same
+# command, and only when their content changes.
+INFO_RULES_MK = $(shell $(QMK_BIN) generate-keyboard-files --quiet --escape --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src)
+ifeq ($(strip $(INFO_RULES_MK)),)
+    $(error Could not generate the files derived from info.json for $(KEYBOARD), see the errors above)
+endif
 include $(INFO_RULES_MK)
 
 # Check for keymap.json first, so we can regenerate keymap.c
@@ -304,46 +308,9 @@ ifneq ("$(wildcard $(KEYBOARD_PATH_5)/post_config.h)","")
 endif
 
 # Pull in stuff from info.json
-INFO_JSON_FILES :=
-ifneq ("$(wildcard $(KEYBOARD_PATH_1)/info.json)","")
-    INFO_JSON_FILES += $(KEYBOARD_PATH_1)/info.json
-endif
-ifneq ("$(wildcard $(KEYBOARD_PATH_2)/info.json)","")
-    INFO_JSON_FILES += $(KEYBOARD_PATH_2)/info.json
-endif
-ifneq ("$(wildcard $(KEYBOARD_PATH_3)/info.json)","")
-    INFO_JSON_FILES += $(KEYBOARD_PATH_3)/info.json
-endif
-ifneq ("$(wildcard $(KEYBOARD_PATH_4)/info.json)","")
-    INFO_JSON_FILES += $(KEYBOARD_PATH_4)/info.json
-endif
-ifneq ("$(wildcard $(KEYBOARD_PATH_5)/info.json)","")
-    INFO_JSON_FILES += $(KEYBOARD_PATH_5)/info.json
-endif
-
 CONFIG_H += $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/layouts.h
 KEYBOARD_SRC += $(KEYBOARD_OUTPUT)/src/default_keyboard.c
 
-$(KEYBOARD_OUTPUT)/src/info_config.h: $(INFO_JSON_FILES)
-	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) generate-config-h --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/info_config.h)
-	@$(BUILD_CMD)
-
-$(KEYBOARD_OUTPUT)/src/default_keyboard.c: $(INFO_JSON_FILES)
-	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) generate-keyboard-c --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/default_keyboard.c)
-	@$(BUILD_CMD)
-
-$(KEYBOARD_OUTPUT)/src/default_keyboard.h: $(INFO_JSON_FILES)
-	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) generate-keyboard-h --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/default_keyboard.h)
-	@$(BUILD_CMD)
-
-$(KEYBOARD_OUTPUT)/src/layouts.h: $(INFO_JSON_FILES)
-	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
-	$(eval CMD=$(QMK_BIN) generate-layouts --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/layouts.h)
-	@$(BUILD_CMD)
-
 generated-files: $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/default_keyboard.c $(KEYBOARD_OUTPUT)/src/default_keyboard.h $(KEYBOARD_OUTPUT)/src/layouts.h
 
 .INTERMEDIATE : generated-files
@@ -477,3 +444,24 @@ define GEN_FILES
 $1: generated-files
 endef
 $(foreach O,$(OBJ),$(eval $(call GEN_FILES,$(patsubst %.a,%.o,$(O)))))
+
+# Precompile quantum.h once for this MCU and feature set, and use it for everything built from quantum/.
+# The stub header includes the real one, so GCC can fall back to it if it decides the .gch is not usable.
+ifeq ($(strip $(PCH_ENABLE)), yes)
+PCH_HEADER := $(KEYMAP_OUTPUT)/pch/quantum_pch.h
+PCH_OBJ := $(filter $(KEYMAP_OUTPUT)/quantum/%.o,$(OBJ))
+
+$(PCH_OBJ): $(PCH_HEADER).gch
+$(PCH_OBJ): PCH_CFLAGS := -include $(PCH_HEADER)
+
+$(PCH_HEADER):
+	@mkdir -p $(@D)
+	echo '#include "quantum.h"' > $@
+
+$(PCH_HEADER).gch: $(PCH_HEADER) $(KEYMAP_OUTPUT)/cflags.txt $(KEYMAP_OUTPUT)/compiler.txt generated-files | $(BEGIN)
+	@$(SILENT) || printf "$(MSG_PRECOMPILING) $<" | $(AWK_CMD)
+	$(eval CMD := $(CC) -x c-header -c $($(KEYMAP_OUTPUT)_CFLAGS) -MMD -MP -MF $(PCH_HEADER).d $< -o $@)
+	@$(BUILD_CMD)
+
+-include $(PCH_HEADER).d
+endif
@@ -60,6 +60,7 @@ MSG_EXECUTING = Executing:
 MSG_LINKING = Linking:
 MSG_COMPILING = Compiling:
 MSG_COMPILING_CXX = Compiling:
+MSG_PRECOMPILING = Precompiling:
 MSG_ASSEMBLING = Assembling:
 MSG_CLEANING = Cleaning project:
 MSG_CREATING_LIBRARY = Creating library:
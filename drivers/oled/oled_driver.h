@@ -170,6 +170,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_INTERVAL 50
 #endif
 
+// Time in ms oled_render may keep sending dirty blocks for, 0 sends a single block per call
+#if !defined(OLED_RENDER_TIME_BUDGET)
+#    define OLED_RENDER_TIME_BUDGET 0
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
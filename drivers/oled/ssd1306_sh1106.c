@@ -132,6 +132,13 @@ uint32_t oled_scroll_timeout;
 uint16_t oled_update_timeout;
 #endif
 
+#ifdef OLED_SHADOW_BUFFER
+// Last data sent to the display, so renders can skip the bytes the display already shows.
+// Only blocks flagged in oled_shadow_valid are known to match the display memory.
+static uint8_t         oled_shadow[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_shadow_valid = 0;
+#endif
+
 // Internal variables to reduce math instructions
 
 #if defined(__AVR__)
@@ -226,6 +233,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#ifdef OLED_SHADOW_BUFFER
+    oled_shadow_valid = 0;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -290,66 +300,168 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
-void oled_render(void) {
-    if (!oled_initialized) {
-        return;
-    }
+// Sends the buffer bytes [start, end) of a single page, addressing only the affected columns
+static bool oled_send_window(uint16_t start, uint16_t end) {
+    uint8_t page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t column = start % OLED_DISPLAY_WIDTH;
+#if (OLED_IC == OLED_IC_SH1106)
+    // Page Addressing Mode has no end bound, the data length limits the update
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + column) & 0x0f), PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + column) >> 4 & 0x0f), NOP, NOP, NOP};
+#else
+    // The end page used to be sent as 0, which the window never reaches either way
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, column, column + (end - start) - 1, PAGE_ADDR, page, page};
+#endif
 
-    // Do we have work to do?
-    oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || oled_scrolling) {
-        return;
+    if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+        print("oled_render offset command failed\n");
+        return false;
     }
 
-    // Find first dirty block
-    uint8_t update_start = 0;
-    while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
-        ++update_start;
+    if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[start], end - start) != I2C_STATUS_SUCCESS) {
+        print("oled_render data failed\n");
+        return false;
     }
+    return true;
+}
 
-    // Set column & page position
-    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-        calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-    } else {
-        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+// Returns the last block of the transfer starting at first_block
+static uint8_t oled_coalesce_blocks(uint8_t first_block) {
+    uint8_t last_block = first_block;
+#if OLED_RENDER_TIME_BUDGET > 0
+    // Merge the following dirty blocks of the same page, saving their addressing commands
+    const uint8_t page_blocks = OLED_DISPLAY_WIDTH / OLED_BLOCK_SIZE;
+    while ((last_block + 1) % page_blocks != 0 && (oled_dirty & ((OLED_BLOCK_TYPE)1 << (last_block + 1)))) {
+        ++last_block;
     }
+#endif
+    return last_block;
+}
 
-    // Send column & page position
-    if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
-        print("oled_render offset command failed\n");
-        return;
-    }
+// Sends the next dirty region of the buffer.
+// Returns false if nothing was sent, either because everything is clean or the transfer failed.
+static bool oled_render_next(void) {
+    while (oled_dirty) {
+        // Find first dirty block
+        uint8_t update_start = 0;
+        while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
+            ++update_start;
+        }
 
-    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-        // Send render data chunk as is
-        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
-            print("oled_render data failed\n");
-            return;
+        // Unrotated blocks that don't span pages are sent through a column window
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90) && OLED_DISPLAY_WIDTH % OLED_BLOCK_SIZE == 0) {
+            uint8_t         update_end = oled_coalesce_blocks(update_start);
+            OLED_BLOCK_TYPE blocks     = 0;
+            for (uint8_t i = update_start; i <= update_end; ++i) {
+                blocks |= ((OLED_BLOCK_TYPE)1 << i);
+            }
+
+            uint16_t start = OLED_BLOCK_SIZE * update_start;
+            uint16_t end   = OLED_BLOCK_SIZE * (update_end + 1);
+#ifdef OLED_SHADOW_BUFFER
+            // Trim unchanged bytes from both ends of the window
+            while (start < end && (oled_shadow_valid & ((OLED_BLOCK_TYPE)1 << (start / OLED_BLOCK_SIZE))) && oled_buffer[start] == oled_shadow[start]) {
+                ++start;
+            }
+            while (end > start && (oled_shadow_valid & ((OLED_BLOCK_TYPE)1 << ((end - 1) / OLED_BLOCK_SIZE))) && oled_buffer[end - 1] == oled_shadow[end - 1]) {
+                --end;
+            }
+            if (start == end) {
+                // Display is already up to date
+                oled_dirty &= ~blocks;
+                continue;
+            }
+#endif
+
+            if (!oled_send_window(start, end)) {
+#ifdef OLED_SHADOW_BUFFER
+                oled_shadow_valid &= ~blocks;
+#endif
+                return false;
+            }
+
+#ifdef OLED_SHADOW_BUFFER
+            memcpy(&oled_shadow[start], &oled_buffer[start], end - start);
+            oled_shadow_valid |= blocks;
+#endif
+            oled_dirty &= ~blocks;
+            return true;
         }
-    } else {
-        // Rotate the render chunks
-        const static uint8_t source_map[] = OLED_SOURCE_MAP;
-        const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-        memset(temp_buffer, 0, sizeof(temp_buffer));
-        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+
+        // Set column & page position
+        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+        } else {
+            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+        }
+
+        // Send column & page position
+        if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+            print("oled_render offset command failed\n");
+            return false;
         }
 
-        // Send render data chunk after rotating
-        if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
-            print("oled_render90 data failed\n");
-            return;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            // Send render data chunk as is
+            if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+                print("oled_render data failed\n");
+                return false;
+            }
+        } else {
+            // Rotate the render chunks
+            const static uint8_t source_map[] = OLED_SOURCE_MAP;
+            const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+            memset(temp_buffer, 0, sizeof(temp_buffer));
+            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+            }
+
+            // Send render data chunk after rotating
+            if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+                print("oled_render90 data failed\n");
+                return false;
+            }
         }
+
+        // Clear dirty flag
+        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        return true;
+    }
+    return false;
+}
+
+void oled_render(void) {
+    if (!oled_initialized) {
+        return;
+    }
+
+    // Do we have work to do?
+    oled_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_dirty || oled_scrolling) {
+        return;
     }
 
-    // Turn on display if it is off
-    oled_on();
+#if OLED_RENDER_TIME_BUDGET > 0
+    // Keep sending until the display is up to date or the time budget is used up
+    uint16_t render_start = timer_read();
+    bool     rendered     = false;
+    while (oled_render_next()) {
+        rendered = true;
+        if (timer_elapsed(render_start) >= OLED_RENDER_TIME_BUDGET) {
+            break;
+        }
+    }
+#else
+    bool rendered = oled_render_next();
+#endif
 
-    // Clear dirty flag
-    oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+    // Turn on display if it is off, as for any rendered frame; also when the shadow buffer found
+    // nothing to send, so rewriting the same content still wakes the display and resets the timeout
+    if (rendered || !oled_dirty) {
+        oled_on();
+    }
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -698,6 +810,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SHADOW_BUFFER
+        // Scrolling moved the display contents around
+        oled_shadow_valid = 0;
+#endif
     }
     return !oled_scrolling;
 }
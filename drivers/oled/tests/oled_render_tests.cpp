@@ -0,0 +1,161 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "oled_driver.h"
+#include "i2c_master.h"
+#include "timer.h"
+
+extern OLED_BLOCK_TYPE oled_dirty;
+
+void set_time(uint32_t t);
+}
+
+// Addressing command plus data register byte, sent with every transfer
+#define OLED_TRANSFER_OVERHEAD (7 + 1)
+
+// What the one-block-per-call renderer sends for the given dirty blocks
+static uint32_t legacy_bytes(OLED_BLOCK_TYPE dirty) {
+    return __builtin_popcount(dirty) * (OLED_TRANSFER_OVERHEAD + OLED_BLOCK_SIZE);
+}
+
+class OledRender : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+        render_frame();
+    }
+
+    // Renders until the display is up to date, returning the bytes sent
+    uint32_t render_frame() {
+        i2c_mock_stats = {};
+        calls          = 0;
+        while (oled_dirty) {
+            oled_render();
+            calls++;
+        }
+        return i2c_mock_stats.bytes;
+    }
+
+    void write_screen(char first) {
+        oled_set_cursor(0, 0);
+        for (uint8_t line = 0; line < oled_max_lines(); line++) {
+            for (uint8_t col = 0; col < oled_max_chars(); col++) {
+                oled_write_char(first + (line + col) % 26, false);
+            }
+        }
+    }
+
+    uint32_t calls;
+};
+
+TEST_F(OledRender, FullRedraw) {
+    write_screen('A');
+    uint32_t legacy = legacy_bytes(oled_dirty);
+    uint32_t bytes  = render_frame();
+
+#if OLED_RENDER_TIME_BUDGET > 0
+    // Every page goes out as a single transfer
+    EXPECT_EQ(i2c_mock_stats.transfers, 2U * (OLED_DISPLAY_HEIGHT / 8));
+    EXPECT_LE(bytes, (OLED_DISPLAY_HEIGHT / 8) * (OLED_TRANSFER_OVERHEAD + OLED_DISPLAY_WIDTH));
+    EXPECT_LT(bytes, legacy);
+    EXPECT_LT(calls, OLED_BLOCK_COUNT);
+#elif defined(OLED_SHADOW_BUFFER)
+    EXPECT_LE(bytes, legacy);
+#else
+    EXPECT_EQ(bytes, legacy);
+#endif
+}
+
+TEST_F(OledRender, SingleCharacter) {
+    write_screen('A');
+    render_frame();
+
+    oled_set_cursor(1, 1);
+    oled_write_char('#', false);
+    uint32_t legacy = legacy_bytes(oled_dirty);
+    uint32_t bytes  = render_frame();
+
+    EXPECT_EQ(legacy, OLED_TRANSFER_OVERHEAD + OLED_BLOCK_SIZE);
+#ifdef OLED_SHADOW_BUFFER
+    // Only the columns of the changed glyph are sent
+    EXPECT_GT(bytes, 0U);
+    EXPECT_LE(bytes, OLED_TRANSFER_OVERHEAD + OLED_FONT_WIDTH);
+#else
+    EXPECT_EQ(bytes, legacy);
+#endif
+}
+
+TEST_F(OledRender, ClearAndRewriteSameContent) {
+    write_screen('A');
+    render_frame();
+
+    oled_clear();
+    write_screen('A');
+    uint32_t legacy = legacy_bytes(oled_dirty);
+    uint32_t bytes  = render_frame();
+
+#ifdef OLED_SHADOW_BUFFER
+    // The display already shows all of it
+    EXPECT_GT(legacy, 0U);
+    EXPECT_EQ(bytes, 0U);
+#elif OLED_RENDER_TIME_BUDGET > 0
+    EXPECT_LT(bytes, legacy);
+#else
+    EXPECT_EQ(bytes, legacy);
+#endif
+}
+
+TEST_F(OledRender, RenderTurnsDisplayOn) {
+    write_screen('A');
+    render_frame();
+
+    ASSERT_TRUE(oled_off());
+    oled_clear();
+    write_screen('A');
+    render_frame();
+    EXPECT_TRUE(is_oled_on());
+}
+
+TEST_F(OledRender, ScrollOffResendsEverything) {
+    write_screen('A');
+    render_frame();
+
+    ASSERT_TRUE(oled_scroll_left());
+    ASSERT_TRUE(oled_scroll_off());
+    EXPECT_EQ(__builtin_popcount(oled_dirty), OLED_BLOCK_COUNT);
+    EXPECT_GE(render_frame(), (uint32_t)OLED_MATRIX_SIZE);
+}
+
+#if OLED_RENDER_TIME_BUDGET > 0
+TEST_F(OledRender, TimeBudget) {
+    write_screen('A');
+
+    i2c_mock_stats = {};
+    while (oled_dirty) {
+        uint32_t start     = timer_read32();
+        uint32_t transfers = i2c_mock_stats.transfers;
+        oled_render();
+
+        // Stops at the first transfer that ends past the budget
+        EXPECT_LE(timer_read32() - start, (uint32_t)OLED_RENDER_TIME_BUDGET + 4);
+        EXPECT_GE(i2c_mock_stats.transfers - transfers, 2U);
+    }
+}
+#endif
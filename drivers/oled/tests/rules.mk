@@ -0,0 +1,13 @@
+oled_render_CONFIG := $(DRIVER_PATH)/oled/tests/config_oled.h
+oled_render_INC := $(DRIVER_PATH)/oled/tests $(DRIVER_PATH)/oled
+
+oled_render_SRC := \
+	platforms/test/timer.c \
+	$(DRIVER_PATH)/oled/tests/i2c_mock.c \
+	$(DRIVER_PATH)/oled/tests/oled_render_tests.cpp \
+	$(DRIVER_PATH)/oled/ssd1306_sh1106.c
+
+oled_render_partial_DEFS := -DOLED_SHADOW_BUFFER -DOLED_RENDER_TIME_BUDGET=5
+oled_render_partial_CONFIG := $(oled_render_CONFIG)
+oled_render_partial_INC := $(oled_render_INC)
+oled_render_partial_SRC := $(oled_render_SRC)
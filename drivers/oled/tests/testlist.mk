@@ -0,0 +1 @@
+TEST_LIST += oled_render oled_render_partial
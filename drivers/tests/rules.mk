@@ -0,0 +1,4 @@
+ws2812_encode_INC := $(DRIVER_PATH)
+
+ws2812_encode_SRC := \
+	$(DRIVER_PATH)/tests/ws2812_encode_tests.cpp
@@ -0,0 +1,52 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_encode.h"
+}
+
+TEST(WS2812Encode, StreamByteUsesTwoBitsPerWireByte) {
+    uint8_t tx[WS2812_STREAM_BYTES_PER_BYTE];
+
+    ws2812_encode_stream_byte(tx, 0x1B); // 00 01 10 11
+    EXPECT_EQ(tx[0], 0x88);
+    EXPECT_EQ(tx[1], 0x8E);
+    EXPECT_EQ(tx[2], 0xE8);
+    EXPECT_EQ(tx[3], 0xEE);
+}
+
+TEST(WS2812Encode, StreamLedFollowsByteOrder) {
+    LED_TYPE color = {};
+    color.r        = 0x00;
+    color.g        = 0xA5;
+    color.b        = 0xFF;
+
+    uint8_t tx[WS2812_STREAM_BYTES_PER_LED];
+    ws2812_encode_stream_led(tx, color);
+
+    // Default byte order is GRB
+    const uint8_t expected[] = {
+        0xE8, 0xE8, 0x8E, 0x8E, // g = 10 10 01 01
+        0x88, 0x88, 0x88, 0x88, // r = 00 00 00 00
+        0xEE, 0xEE, 0xEE, 0xEE, // b = 11 11 11 11
+    };
+    ASSERT_EQ(sizeof(expected), sizeof(tx));
+    for (size_t i = 0; i < sizeof(tx); i++) {
+        EXPECT_EQ(tx[i], expected[i]) << "at byte " << i;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "quantum/color.h"
+
+/*
+ * Encoding shared by the WS2812 drivers, so that byte order, RGBW handling and
+ * the wire format are computed the same way whichever peripheral sends the frame.
+ */
+
+#ifdef RGBW
+#    define WS2812_CHANNELS 4
+#else
+#    define WS2812_CHANNELS 3
+#endif
+
+/**
+ * @brief Writes the bytes of one LED in the order they go out on the wire
+ *
+ * @param[out] out WS2812_CHANNELS bytes
+ * @param[in] color LED_TYPE to encode
+ */
+static inline void ws2812_encode_color(uint8_t *out, LED_TYPE color) {
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+    out[0] = color.g;
+    out[1] = color.r;
+    out[2] = color.b;
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+    out[0] = color.r;
+    out[1] = color.g;
+    out[2] = color.b;
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+    out[0] = color.b;
+    out[1] = color.g;
+    out[2] = color.r;
+#endif
+#ifdef RGBW
+    out[3] = color.w;
+#endif
+}
+
+/*
+ * When a frame is clocked out as a plain bit stream (e.g. over SPI MOSI), every
+ * two data bits are translated into one byte on the wire, each data bit being
+ * sent as 0b1000 for a 0 and 0b1110 for a 1.
+ */
+#define WS2812_STREAM_BYTES_PER_BYTE 4
+#define WS2812_STREAM_BYTES_PER_LED (WS2812_STREAM_BYTES_PER_BYTE * WS2812_CHANNELS)
+
+/**
+ * @brief Encodes one data byte into its bit stream form, using a lookup table rather than per bit branches
+ *
+ * @param[out] tx WS2812_STREAM_BYTES_PER_BYTE bytes
+ * @param[in] data byte to encode
+ */
+static inline void ws2812_encode_stream_byte(uint8_t *tx, uint8_t data) {
+    static const uint8_t lut[4] = {0x88, 0x8E, 0xE8, 0xEE};
+
+    tx[0] = lut[data >> 6];
+    tx[1] = lut[(data >> 4) & 0x03];
+    tx[2] = lut[(data >> 2) & 0x03];
+    tx[3] = lut[data & 0x03];
+}
+
+/**
+ * @brief Encodes one LED into its bit stream form
+ *
+ * @param[out] tx WS2812_STREAM_BYTES_PER_LED bytes
+ * @param[in] color LED_TYPE to encode
+ */
+static inline void ws2812_encode_stream_led(uint8_t *tx, LED_TYPE color) {
+    uint8_t bytes[WS2812_CHANNELS];
+    ws2812_encode_color(bytes, color);
+    for (uint8_t i = 0; i < WS2812_CHANNELS; i++) {
+        ws2812_encode_stream_byte(tx + i * WS2812_STREAM_BYTES_PER_BYTE, bytes[i]);
+    }
+}
@@ -37,6 +37,7 @@ subcommands = [
     'qmk.cli.chibios.confmigrate',
     'qmk.cli.clean',
     'qmk.cli.compile',
+    'qmk.cli.console_trace',
     'qmk.cli.docs',
     'qmk.cli.doctor',
     'qmk.cli.fileformat',
@@ -53,6 +54,7 @@ subcommands = [
     'qmk.cli.generate.docs',
     'qmk.cli.generate.info_json',
     'qmk.cli.generate.keyboard_c',
+    'qmk.cli.generate.keyboard_files',
     'qmk.cli.generate.keyboard_h',
     'qmk.cli.generate.layouts',
     'qmk.cli.generate.rgb_breathe_table',
@@ -0,0 +1,59 @@
+"""Decode the binary console trace of a keyboard built with CONSOLE_TRACE_ENABLE.
+"""
+import sys
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+import qmk.path
+from qmk.console_trace import ElfImage, TraceDecoder
+
+CONSOLE_USAGE_PAGE = 0xFF31
+CONSOLE_USAGE = 0x0074
+CONSOLE_EPSIZE = 32
+
+
+def _open_console(device):
+    """Opens the HID console of the first matching keyboard.
+    """
+    import hid
+
+    vid, pid = (int(part, 16) for part in device.split(':')) if device else (0, 0)
+    for info in hid.enumerate(vid, pid):
+        if info['usage_page'] == CONSOLE_USAGE_PAGE and info['usage'] == CONSOLE_USAGE:
+            cli.log.info('Listening to %s %s (%04X:%04X)', info['manufacturer_string'], info['product_string'], info['vendor_id'], info['product_id'])
+            return hid.Device(path=info['path'])
+    return None
+
+
+@cli.argument('firmware', arg_only=True, type=qmk.path.normpath, completer=FilesCompleter('.elf'), help='The .elf file of the firmware running on the keyboard.')
+@cli.argument('-i', '--input', arg_only=True, type=qmk.path.normpath, help='Decode a captured stream from this file instead of listening to the keyboard.')
+@cli.argument('-d', '--device', arg_only=True, help='Listen to the keyboard with this VID:PID, in hex. Default: the first with a console.')
+@cli.subcommand('Decodes the binary console trace of a keyboard.')
+def console_trace(cli):
+    """Formats the messages of a keyboard built with CONSOLE_TRACE_ENABLE = yes, using the format strings in its firmware.
+    """
+    try:
+        elf = ElfImage(cli.args.firmware.read_bytes())
+        decoder = TraceDecoder(elf.formats(), elf.string)
+    except (OSError, ValueError) as e:
+        cli.log.error('Could not read %s: %s', cli.args.firmware, e)
+        return False
+
+    if cli.args.input:
+        sys.stdout.write(decoder.feed(cli.args.input.read_bytes()))
+        return True
+
+    console = _open_console(cli.args.device)
+    if not console:
+        cli.log.error('No keyboard with a console found.')
+        return False
+
+    try:
+        while True:
+            sys.stdout.write(decoder.feed(console.read(CONSOLE_EPSIZE)))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        return True
+    finally:
+        console.close()
@@ -8,14 +8,17 @@ from milc import cli
 
 from qmk.datetime import current_datetime
 from qmk.info import info_json
+from qmk.info_cache import stats as info_cache_stats
 from qmk.json_encoders import InfoJSONEncoder
 from qmk.json_schema import json_load
 from qmk.keyboard import find_readme, list_keyboards
+from qmk.parallel import parallel_map
 
 TEMPLATE_PATH = Path('data/templates/api/')
 BUILD_API_PATH = Path('.build/api_data/')
 
 
+@cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of processes used to generate the keyboard data; 0 means one per CPU.")
 @cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't write the data to disk.")
 @cli.argument('-f', '--filter', arg_only=True, action='append', default=[], help="Filter the list of keyboards based on partial name matches the supplied value. May be passed multiple times.")
 @cli.subcommand('Creates a new keymap for the keyboard of your choosing', hidden=False if cli.config.user.developer else True)
@@ -47,8 +50,8 @@ def generate_api(cli):
     usb_list = {}
 
     # Generate and write keyboard specific JSON files
-    for keyboard_name in keyboard_list:
-        kb_all[keyboard_name] = info_json(keyboard_name)
+    for keyboard_name, info_data in zip(keyboard_list, parallel_map(info_json, keyboard_list, cli.args.parallel)):
+        kb_all[keyboard_name] = info_data
         keyboard_dir = v1_dir / 'keyboards' / keyboard_name
         keyboard_info = keyboard_dir / 'info.json'
         keyboard_readme = keyboard_dir / 'readme.md'
@@ -99,3 +102,5 @@ def generate_api(cli):
         keyboard_list_file.write_text(keyboard_list_json)
         keyboard_aliases_file.write_text(keyboard_aliases_json)
         keyboard_metadata_file.write_text(keyboard_metadata_json)
+
+    cli.log.info(info_cache_stats.summary())
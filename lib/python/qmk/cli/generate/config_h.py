@@ -174,6 +174,25 @@ def generate_split_config(kb_info_json, config_h_lines):
         config_h_lines.append(matrix_pins(kb_info_json['split']['matrix_pins']['right'], '_RIGHT'))
 
 
+def generate_config_h_lines(kb_info_json):
+    """Return the lines of the info_config.h generated from info.json data.
+    """
+    # Build the info_config.h file.
+    config_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once']
+
+    generate_config_items(kb_info_json, config_h_lines)
+
+    generate_matrix_size(kb_info_json, config_h_lines)
+
+    if 'matrix_pins' in kb_info_json:
+        config_h_lines.append(matrix_pins(kb_info_json['matrix_pins']))
+
+    if 'split' in kb_info_json:
+        generate_split_config(kb_info_json, config_h_lines)
+
+    return config_h_lines
+
+
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate config.h for.')
@@ -188,18 +207,7 @@ def generate_config_h(cli):
     else:
         kb_info_json = dotty(info_json(cli.args.keyboard))
 
-    # Build the info_config.h file.
-    config_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once']
-
-    generate_config_items(kb_info_json, config_h_lines)
-
-    generate_matrix_size(kb_info_json, config_h_lines)
-
-    if 'matrix_pins' in kb_info_json:
-        config_h_lines.append(matrix_pins(kb_info_json['matrix_pins']))
-
-    if 'split' in kb_info_json:
-        generate_split_config(kb_info_json, config_h_lines)
+    config_h_lines = generate_config_h_lines(kb_info_json)
 
     # Show the results
     dump_lines(cli.args.output, config_h_lines, cli.args.quiet)
@@ -57,6 +57,17 @@ def _gen_led_config(info_data):
     return lines
 
 
+def generate_keyboard_c_lines(kb_info_json):
+    """Return the lines of the keyboard.c generated from info.json data.
+    """
+    # Build the layouts.h file.
+    keyboard_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#include QMK_KEYBOARD_H', '']
+
+    keyboard_h_lines.extend(_gen_led_config(kb_info_json))
+
+    return keyboard_h_lines
+
+
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.c for.')
@@ -66,10 +77,7 @@ def generate_keyboard_c(cli):
     """
     kb_info_json = info_json(cli.args.keyboard)
 
-    # Build the layouts.h file.
-    keyboard_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#include QMK_KEYBOARD_H', '']
-
-    keyboard_h_lines.extend(_gen_led_config(kb_info_json))
+    keyboard_h_lines = generate_keyboard_c_lines(kb_info_json)
 
     # Show the results
     dump_lines(cli.args.output, keyboard_h_lines, cli.args.quiet)
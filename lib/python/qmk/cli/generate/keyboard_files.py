@@ -0,0 +1,56 @@
+"""Used by the make system to generate all files derived from a keyboard's info.json at once.
+"""
+from dotty_dict import dotty
+from milc import cli
+
+from qmk.info import info_json
+from qmk.commands import dump_lines_if_changed
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.path import normpath
+from qmk.cli.generate.config_h import generate_config_h_lines
+from qmk.cli.generate.keyboard_c import generate_keyboard_c_lines
+from qmk.cli.generate.keyboard_h import generate_keyboard_h_lines
+from qmk.cli.generate.layouts import generate_layouts_h_lines
+from qmk.cli.generate.rules_mk import generate_rules_mk_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, required=True, help='Folder to write the files to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate the files for.')
+@cli.subcommand('Used by the make system to generate info_rules.mk, info_config.h, layouts.h and default_keyboard.c/h from info.json', hidden=True)
+def generate_keyboard_files(cli):
+    """Generates every per-keyboard file from a single resolve of info.json.
+
+    Files whose content did not change are not touched, so an incremental build only recompiles what an info.json change actually affects. Prints the path of info_rules.mk for the make system to include.
+    """
+    kb_info_json = info_json(cli.args.keyboard)
+
+    layouts_h_lines = generate_layouts_h_lines(cli.args.keyboard, kb_info_json)
+
+    files = {
+        'info_rules.mk': generate_rules_mk_lines(dotty(kb_info_json)),
+        'info_config.h': generate_config_h_lines(dotty(kb_info_json)),
+        'layouts.h': layouts_h_lines,
+        'default_keyboard.c': generate_keyboard_c_lines(kb_info_json),
+        'default_keyboard.h': generate_keyboard_h_lines(cli.args.keyboard, kb_info_json),
+    }
+
+    for name, lines in files.items():
+        if lines is None:
+            # Don't leave a stale copy behind for anything to pick up
+            if (cli.args.output / name).exists():
+                (cli.args.output / name).unlink()
+        elif dump_lines_if_changed(cli.args.output / name, lines) and not cli.args.quiet:
+            cli.log.info('Wrote %s to %s.', name, cli.args.output / name)
+
+    # Without a path to include the make system stops the build
+    if layouts_h_lines is None:
+        return False
+
+    rules_mk = cli.args.output / 'info_rules.mk'
+    if cli.args.quiet:
+        if cli.args.escape:
+            print(rules_mk.as_posix().replace(' ', '\\ '))
+        else:
+            print(rules_mk)
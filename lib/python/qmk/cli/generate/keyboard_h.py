@@ -9,11 +9,12 @@ from qmk.path import normpath
 from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
 
 
-def would_populate_layout_h(keyboard):
+def would_populate_layout_h(keyboard, kb_info_json=None):
     """Detect if a given keyboard is doing data driven layouts
     """
     # Build the info.json file
-    kb_info_json = info_json(keyboard)
+    if kb_info_json is None:
+        kb_info_json = info_json(keyboard)
 
     for layout_name in kb_info_json['layouts']:
         if kb_info_json['layouts'][layout_name]['c_macro']:
@@ -28,14 +29,10 @@ def would_populate_layout_h(keyboard):
     return False
 
 
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.h for.')
-@cli.subcommand('Used by the make system to generate keyboard.h from info.json', hidden=True)
-def generate_keyboard_h(cli):
-    """Generates the keyboard.h file.
+def generate_keyboard_h_lines(keyboard, kb_info_json=None):
+    """Return the lines of the keyboard.h generated for a keyboard.
     """
-    has_layout_h = would_populate_layout_h(cli.args.keyboard)
+    has_layout_h = would_populate_layout_h(keyboard, kb_info_json)
 
     # Build the layouts.h file.
     keyboard_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '#include "quantum.h"']
@@ -43,5 +40,17 @@ def generate_keyboard_h(cli):
     if not has_layout_h:
         keyboard_h_lines.append('#error("<keyboard>.h is only optional for data driven keyboards - kb.h == bad times")')
 
+    return keyboard_h_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.h for.')
+@cli.subcommand('Used by the make system to generate keyboard.h from info.json', hidden=True)
+def generate_keyboard_h(cli):
+    """Generates the keyboard.h file.
+    """
+    keyboard_h_lines = generate_keyboard_h_lines(cli.args.keyboard)
+
     # Show the results
     dump_lines(cli.args.output, keyboard_h_lines, cli.args.quiet)
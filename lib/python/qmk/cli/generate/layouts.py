@@ -16,34 +16,15 @@ usb_properties = {
 }
 
 
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='Keyboard to generate config.h for.')
-@cli.subcommand('Used by the make system to generate layouts.h from info.json', hidden=True)
-@automagic_keyboard
-@automagic_keymap
-def generate_layouts(cli):
-    """Generates the layouts.h file.
+def generate_layouts_h_lines(keyboard, kb_info_json):
+    """Return the lines of the layouts.h generated from info.json data, or None if the data is not usable.
     """
-    # Determine our keyboard(s)
-    if not cli.config.generate_layouts.keyboard:
-        cli.log.error('Missing parameter: --keyboard')
-        cli.subcommands['info'].print_help()
-        return False
-
-    if not is_keyboard(cli.config.generate_layouts.keyboard):
-        cli.log.error('Invalid keyboard: "%s"', cli.config.generate_layouts.keyboard)
-        return False
-
-    # Build the info.json file
-    kb_info_json = info_json(cli.config.generate_layouts.keyboard)
-
     # Build the layouts.h file.
     layouts_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once']
 
     if 'matrix_size' not in kb_info_json:
-        cli.log.error('%s: Invalid matrix config.', cli.config.generate_layouts.keyboard)
-        return False
+        cli.log.error('%s: Invalid matrix config.', keyboard)
+        return None
 
     col_num = kb_info_json['matrix_size']['cols']
     row_num = kb_info_json['matrix_size']['rows']
@@ -53,7 +34,7 @@ def generate_layouts(cli):
             continue
 
         if 'matrix' not in kb_info_json['layouts'][layout_name]['layout'][0]:
-            cli.log.debug('%s/%s: No matrix data!', cli.config.generate_layouts.keyboard, layout_name)
+            cli.log.debug('%s/%s: No matrix data!', keyboard, layout_name)
             continue
 
         layout_keys = []
@@ -70,7 +51,7 @@ def generate_layouts(cli):
             except IndexError:
                 key_name = key.get('label', identifier)
                 cli.log.error('Matrix data out of bounds for layout %s at index %s (%s): %s, %s', layout_name, i, key_name, row, col)
-                return False
+                return None
 
         layouts_h_lines.append('')
         layouts_h_lines.append('#define %s(%s) {\\' % (layout_name, ', '.join(layout_keys)))
@@ -86,5 +67,34 @@ def generate_layouts(cli):
         layouts_h_lines.append(f'#   define {alias} {target}')
         layouts_h_lines.append('#endif')
 
+    return layouts_h_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='Keyboard to generate config.h for.')
+@cli.subcommand('Used by the make system to generate layouts.h from info.json', hidden=True)
+@automagic_keyboard
+@automagic_keymap
+def generate_layouts(cli):
+    """Generates the layouts.h file.
+    """
+    # Determine our keyboard(s)
+    if not cli.config.generate_layouts.keyboard:
+        cli.log.error('Missing parameter: --keyboard')
+        cli.subcommands['info'].print_help()
+        return False
+
+    if not is_keyboard(cli.config.generate_layouts.keyboard):
+        cli.log.error('Invalid keyboard: "%s"', cli.config.generate_layouts.keyboard)
+        return False
+
+    # Build the info.json file
+    kb_info_json = info_json(cli.config.generate_layouts.keyboard)
+
+    layouts_h_lines = generate_layouts_h_lines(cli.config.generate_layouts.keyboard, kb_info_json)
+    if layouts_h_lines is None:
+        return False
+
     # Show the results
     dump_lines(cli.args.output, layouts_h_lines, cli.args.quiet)
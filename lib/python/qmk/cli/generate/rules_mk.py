@@ -39,21 +39,9 @@ def process_mapping_rule(kb_info_json, rules_key, info_dict):
     return f'{rules_key} ?= {rules_value}'
 
 
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
-@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate rules.mk for.')
-@cli.argument('-km', '--keymap', arg_only=True, help='Keymap to generate rules.mk for.')
-@cli.subcommand('Used by the make system to generate rules.mk from info.json', hidden=True)
-def generate_rules_mk(cli):
-    """Generates a rules.mk file from info.json.
+def generate_rules_mk_lines(kb_info_json):
+    """Return the lines of the rules.mk generated from info.json data.
     """
-    # Determine our keyboard/keymap
-    if cli.args.keymap:
-        kb_info_json = dotty(keymap_json_config(cli.args.keyboard, cli.args.keymap))
-    else:
-        kb_info_json = dotty(info_json(cli.args.keyboard))
-
     info_rules_map = json_load(Path('data/mappings/info_rules.json'))
     rules_mk_lines = [GPL2_HEADER_SH_LIKE, GENERATED_HEADER_SH_LIKE]
 
@@ -82,6 +70,26 @@ def generate_rules_mk(cli):
         else:
             rules_mk_lines.append('CUSTOM_MATRIX ?= yes')
 
+    return rules_mk_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate rules.mk for.')
+@cli.argument('-km', '--keymap', arg_only=True, help='Keymap to generate rules.mk for.')
+@cli.subcommand('Used by the make system to generate rules.mk from info.json', hidden=True)
+def generate_rules_mk(cli):
+    """Generates a rules.mk file from info.json.
+    """
+    # Determine our keyboard/keymap
+    if cli.args.keymap:
+        kb_info_json = dotty(keymap_json_config(cli.args.keyboard, cli.args.keymap))
+    else:
+        kb_info_json = dotty(info_json(cli.args.keyboard))
+
+    rules_mk_lines = generate_rules_mk_lines(kb_info_json)
+
     # Show the results
     dump_lines(cli.args.output, rules_mk_lines)
 
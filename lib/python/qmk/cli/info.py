@@ -12,6 +12,7 @@ from qmk.constants import COL_LETTERS, ROW_LETTERS
 from qmk.decorators import automagic_keyboard, automagic_keymap
 from qmk.keyboard import keyboard_completer, keyboard_folder, render_layouts, render_layout, rules_mk
 from qmk.info import info_json, keymap_json
+from qmk.info_cache import stats as info_cache_stats
 from qmk.keymap import locate_keymap
 from qmk.path import is_keyboard
 
@@ -171,6 +172,8 @@ def info(cli):
     else:
         kb_info_json = info_json(cli.config.info.keyboard)
 
+    cli.log.debug(info_cache_stats.summary())
+
     # Output in the requested format
     if cli.args.format == 'json':
         print(json.dumps(kb_info_json, cls=InfoJSONEncoder))
@@ -6,8 +6,10 @@ from milc import cli
 
 from qmk.decorators import automagic_keyboard, automagic_keymap
 from qmk.info import info_json
+from qmk.info_cache import stats as info_cache_stats
 from qmk.keyboard import keyboard_completer, list_keyboards
 from qmk.keymap import locate_keymap, list_keymaps
+from qmk.parallel import parallel_map
 from qmk.path import is_keyboard, keyboard
 from qmk.git import git_get_ignored_files
 
@@ -122,19 +124,51 @@ def keyboard_check(kb):
     return ok
 
 
+def _lint_keyboard(kb):
+    """Perform all checks for a keyboard and the keymaps selected on the command line.
+
+    Returns None if the keyboard does not exist.
+    """
+    if not is_keyboard(kb):
+        cli.log.error('No such keyboard: %s', kb)
+        return None
+
+    # Determine keymaps to also check
+    if cli.args.all_km:
+        keymaps = list_keymaps(kb)
+    elif cli.config.lint.keymap:
+        keymaps = {cli.config.lint.keymap}
+    else:
+        keymaps = _list_defaultish_keymaps(kb)
+        # Ensure that at least a 'default' keymap always exists
+        keymaps.add('default')
+
+    ok = True
+
+    # keyboard level checks
+    if not keyboard_check(kb):
+        ok = False
+
+    # Keymap specific checks
+    for keymap in keymaps:
+        if not keymap_check(kb, keymap):
+            ok = False
+
+    return ok
+
+
 @cli.argument('--strict', action='store_true', help='Treat warnings as errors')
 @cli.argument('-kb', '--keyboard', completer=keyboard_completer, help='Comma separated list of keyboards to check')
 @cli.argument('-km', '--keymap', help='The keymap to check')
 @cli.argument('--all-kb', action='store_true', arg_only=True, help='Check all keyboards')
 @cli.argument('--all-km', action='store_true', arg_only=True, help='Check all keymaps')
+@cli.argument('-j', '--parallel', type=int, default=1, arg_only=True, help='Set the number of keyboards to check in parallel; 0 means one per CPU.')
 @cli.subcommand('Check keyboard and keymap for common mistakes.')
 @automagic_keyboard
 @automagic_keymap
 def lint(cli):
     """Check keyboard and keymap for common mistakes.
     """
-    failed = []
-
     # Determine our keyboard list
     if cli.args.all_kb:
         if cli.args.keyboard:
@@ -149,35 +183,11 @@ def lint(cli):
         keyboard_list = cli.config.lint.keyboard.split(',')
 
     # Lint each keyboard
-    for kb in keyboard_list:
-        if not is_keyboard(kb):
-            cli.log.error('No such keyboard: %s', kb)
-            continue
-
-        # Determine keymaps to also check
-        if cli.args.all_km:
-            keymaps = list_keymaps(kb)
-        elif cli.config.lint.keymap:
-            keymaps = {cli.config.lint.keymap}
-        else:
-            keymaps = _list_defaultish_keymaps(kb)
-            # Ensure that at least a 'default' keymap always exists
-            keymaps.add('default')
+    results = parallel_map(_lint_keyboard, keyboard_list, cli.args.parallel)
+    failed = [kb for kb, ok in zip(keyboard_list, results) if ok is False]
 
-        ok = True
-
-        # keyboard level checks
-        if not keyboard_check(kb):
-            ok = False
-
-        # Keymap specific checks
-        for keymap in keymaps:
-            if not keymap_check(kb, keymap):
-                ok = False
-
-        # Report status
-        if not ok:
-            failed.append(kb)
+    if cli.args.all_kb:
+        cli.log.info(info_cache_stats.summary())
 
     # Check and report the overall status
     if failed:
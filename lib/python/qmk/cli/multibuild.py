@@ -4,6 +4,7 @@ This will compile everything in parallel, for testing purposes.
 """
 import os
 import re
+import time
 from pathlib import Path
 from subprocess import DEVNULL
 
@@ -28,7 +29,43 @@ def _is_split(keyboard_name):
     return True if 'SPLIT_KEYBOARD' in rules_mk and rules_mk['SPLIT_KEYBOARD'].lower() == 'yes' else False
 
 
+# Cache entries that were not used for this long are removed before each build
+COMPILE_CACHE_MAX_AGE_DAYS = 7
+
+
+def _prune_compile_cache(compile_cache):
+    """Removes objects util/compile_cache.py has not used in a while, so the cache does not grow forever.
+    """
+    oldest = time.time() - COMPILE_CACHE_MAX_AGE_DAYS * 24 * 60 * 60
+
+    for metadata in compile_cache.glob('*/*.json'):
+        try:
+            if metadata.stat().st_mtime < oldest:
+                metadata.unlink()
+                metadata.with_suffix('.o').unlink()
+        except OSError:
+            pass
+
+
+def _report_compile_cache(stats_log):
+    """Summarizes what util/compile_cache.py did during this build.
+    """
+    counts = {'hit': 0, 'miss': 0}
+    seconds = {'hit': 0.0, 'miss': 0.0}
+
+    if stats_log.exists():
+        for line in stats_log.read_text().splitlines():
+            result, elapsed = line.split()
+            counts[result] += 1
+            seconds[result] += float(elapsed)
+
+    total = counts['hit'] + counts['miss']
+    if total:
+        cli.log.info('Compile cache: %d hits, %d misses (%.1f%% hit rate), saved %.0fs of CPU time, spent %.0fs looking up objects.', counts['hit'], counts['miss'], 100 * counts['hit'] / total, seconds['hit'], seconds['miss'])
+
+
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
+@cli.argument('--compile-cache', arg_only=True, action='store_true', help="Share object files between keyboards through .build/compile_cache.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-f', '--filter', arg_only=True, action='append', default=[], help="Filter the list of keyboards based on the supplied value in rules.mk. Supported format is 'SPLIT_KEYBOARD=yes'. May be passed multiple times.")
 @cli.argument('-km', '--keymap', type=str, default='default', help="The keymap name to build. Default is 'default'.")
@@ -44,6 +81,8 @@ def multibuild(cli):
 
     builddir = Path(QMK_FIRMWARE) / '.build'
     makefile = builddir / 'parallel_kb_builds.mk'
+    compile_cache = builddir / 'compile_cache'
+    compile_cache_args = f'COMPILE_CACHE_DIR="{compile_cache}"' if cli.args.compile_cache else ''
 
     keyboard_list = qmk.keyboard.list_keyboards()
 
@@ -59,6 +98,10 @@ def multibuild(cli):
         return
 
     builddir.mkdir(parents=True, exist_ok=True)
+    if (compile_cache / 'stats.log').exists():
+        (compile_cache / 'stats.log').unlink()
+    if cli.args.compile_cache:
+        _prune_compile_cache(compile_cache)
     with open(makefile, "w") as f:
         for keyboard_name in keyboard_list:
             if qmk.keymap.locate_keymap(keyboard_name, cli.args.keymap) is not None:
@@ -70,7 +113,7 @@ all: {keyboard_safe}_binary
 {keyboard_safe}_binary:
 	@rm -f "{QMK_FIRMWARE}/.build/failed.log.{keyboard_safe}" || true
 	@echo "Compiling QMK Firmware for target: '{keyboard_name}:{cli.args.keymap}'..." >>"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}"
-	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{cli.args.keymap}" REQUIRE_PLATFORM_KEY= COLOR=true SILENT=false {' '.join(cli.args.env)} \\
+	+@$(MAKE) -C "{QMK_FIRMWARE}" -f "{QMK_FIRMWARE}/builddefs/build_keyboard.mk" KEYBOARD="{keyboard_name}" KEYMAP="{cli.args.keymap}" REQUIRE_PLATFORM_KEY= COLOR=true SILENT=false {compile_cache_args} {' '.join(cli.args.env)} \\
 		>>"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" 2>&1 \\
 		|| cp "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" "{QMK_FIRMWARE}/.build/failed.log.{os.getpid()}.{keyboard_safe}"
 	@{{ grep '\[ERRORS\]' "{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}" >/dev/null 2>&1 && printf "Build %-64s \e[1;31m[ERRORS]\e[0m\\n" "{keyboard_name}:{cli.args.keymap}" ; }} \\
@@ -84,6 +127,8 @@ all: {keyboard_safe}_binary
 
     cli.run([make_cmd, *get_make_parallel_args(cli.args.parallel), '-f', makefile.as_posix(), 'all'], capture_output=False, stdin=DEVNULL)
 
+    _report_compile_cache(compile_cache / 'stats.log')
+
     # Check for failures
     failures = [f for f in builddir.glob(f'failed.log.{os.getpid()}.*')]
     if len(failures) > 0:
@@ -234,3 +234,19 @@ def dump_lines(output_file, lines, quiet=True):
             cli.log.info(f'Wrote {output_file.name} to {output_file}.')
     else:
         print(generated)
+
+
+def dump_lines_if_changed(output_file, lines):
+    """Write the lines to output_file, leaving it alone if it already has that content.
+
+    Keeps the modification time of generated headers, so make does not rebuild everything that includes them.
+
+    Returns True if the file was written.
+    """
+    generated = '\n'.join(lines) + '\n'
+    if output_file.exists() and output_file.read_text(encoding='utf-8') == generated:
+        return False
+
+    output_file.parent.mkdir(parents=True, exist_ok=True)
+    output_file.write_text(generated, encoding='utf-8')
+    return True
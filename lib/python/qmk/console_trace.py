@@ -0,0 +1,177 @@
+"""Decoder for the binary console trace stream, see quantum/logging/console_trace.h.
+"""
+import re
+import struct
+
+RECORD_PADDING = 0x00
+RECORD_DROPPED = 0x01
+RECORD_TEXT = 0x40
+RECORD_FORMAT = 0x80
+MAX_ARGS = 8
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+format_spec = re.compile(r'%([-+ 0#]*)(\d+)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diuxXobcsp%])')
+
+
+class ElfImage:
+    """The parts of a firmware ELF the decoder needs: the format strings, and flash contents for %s.
+    """
+    def __init__(self, data):
+        if data[:4] != b'\x7fELF':
+            raise ValueError('Not an ELF file')
+        if data[5] != 1:
+            raise ValueError('Only little endian ELF files are supported')
+
+        if data[4] == 1:
+            shoff, = struct.unpack_from('<I', data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x2E)
+            section_format = '<IIIIIIIIII'
+        else:
+            shoff, = struct.unpack_from('<Q', data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x3A)
+            section_format = '<IIQQQQIIQQ'
+
+        headers = [struct.unpack_from(section_format, data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+
+        self.sections = {}
+        for name, kind, flags, address, offset, size, *_ in headers:
+            end = data.index(b'\0', names[4] + name)
+            self.sections[data[names[4] + name:end].decode()] = (kind, flags, address, data[offset:offset + size])
+
+    def formats(self):
+        """Returns the contents of the `qmk_trace` section.
+        """
+        if 'qmk_trace' not in self.sections:
+            raise ValueError('No qmk_trace section, was the firmware built with CONSOLE_TRACE_ENABLE = yes?')
+        return self.sections['qmk_trace'][3]
+
+    def string(self, address):
+        """Returns the string at `address` in flash, or None if it is not stored there.
+        """
+        for kind, flags, start, contents in self.sections.values():
+            if kind == SHT_PROGBITS and flags & SHF_ALLOC and start <= address < start + len(contents):
+                offset = address - start
+                end = contents.find(b'\0', offset)
+                return contents[offset:end if end >= 0 else len(contents)].decode(errors='replace')
+        return None
+
+
+def c_string(data, offset):
+    """Reads a NUL terminated string out of `data`.
+    """
+    end = data.find(b'\0', offset)
+    return data[offset:end if end >= 0 else len(data)].decode(errors='replace')
+
+
+def format_c(fmt, args, string=None):
+    """Formats `args` the way lib/printf would, for the 32 bit arguments of a trace record.
+
+    Args:
+
+        fmt
+            The printf style format string
+
+        args
+            The raw argument values
+
+        string
+            Optional function looking up the text of a %s argument by its address
+    """
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+
+        value = args.pop(0) if args else 0
+        bits = {'hh': 8, 'h': 16}.get(length, 32)
+        value &= (1 << bits) - 1
+        if conversion in 'di' and value & (1 << (bits - 1)):
+            value -= 1 << bits
+
+        if conversion == 's':
+            text = string(value) if string else None
+            text = text if text is not None else '<0x%08X>' % value
+            return ('%' + flags + (width or '') + ('.' + precision if precision else '') + 's') % text
+        if conversion == 'c':
+            return ('%' + flags + (width or '') + 'c') % chr(value & 0xFF)
+        if conversion == 'p':
+            return '0x%08X' % value
+        if conversion == 'b':
+            digits = format(value, 'b')
+            width = int(width or 0)
+            fill = '0' if '0' in flags and '-' not in flags else ' '
+            return digits.ljust(width) if '-' in flags else digits.rjust(width, fill)
+
+        python_conversion = {'i': 'd', 'u': 'd'}.get(conversion, conversion)
+        return ('%' + flags + (width or '') + ('.' + precision if precision else '') + python_conversion) % value
+
+    return format_spec.sub(convert, fmt)
+
+
+class TraceDecoder:
+    """Turns the trace stream back into text. Feed it the data as it arrives, in any chunks.
+
+    Args:
+
+        formats
+            The contents of the `qmk_trace` section
+
+        string
+            Optional function looking up the text of a %s argument by its address
+    """
+    def __init__(self, formats, string=None):
+        self.formats = formats
+        self.string = string
+        self.pending = b''
+
+    def feed(self, data):
+        """Decodes `data`, returns the text of all records that are complete.
+        """
+        self.pending += data
+        output = []
+        position = 0
+
+        while position < len(self.pending):
+            tag = self.pending[position]
+
+            if tag == RECORD_PADDING:
+                length = 1
+
+            elif tag == RECORD_DROPPED:
+                length = 3
+                if position + length > len(self.pending):
+                    break
+                count, = struct.unpack_from('<H', self.pending, position + 1)
+                output.append('[%d console messages dropped]\n' % count)
+
+            elif tag & 0xC0 == RECORD_TEXT:
+                length = 1 + (tag & 0x3F)
+                if position + length > len(self.pending):
+                    break
+                output.append(self.pending[position + 1:position + length].decode(errors='replace'))
+
+            elif tag & 0xF0 == RECORD_FORMAT and tag & 0x0F <= MAX_ARGS:
+                count = tag & 0x0F
+                length = 3 + 4 * count
+                if position + length > len(self.pending):
+                    break
+                fmt_id, = struct.unpack_from('<H', self.pending, position + 1)
+                args = struct.unpack_from('<%dI' % count, self.pending, position + 3)
+                if fmt_id < len(self.formats):
+                    output.append(format_c(c_string(self.formats, fmt_id), args, self.string))
+                else:
+                    output.append('[unknown console trace format %d]\n' % fmt_id)
+
+            else:
+                # Joined in the middle of a record, skip ahead until something makes sense
+                length = 1
+
+            position += length
+
+        self.pending = self.pending[position:]
+        return ''.join(output)
@@ -9,6 +9,7 @@ from milc import cli
 
 from qmk.constants import CHIBIOS_PROCESSORS, LUFA_PROCESSORS, VUSB_PROCESSORS
 from qmk.c_parse import find_layouts, parse_config_h_file, find_led_config
+from qmk.info_cache import cached_info_json
 from qmk.json_schema import deep_update, json_load, validate
 from qmk.keyboard import config_h, rules_mk
 from qmk.keymap import list_keymaps, locate_keymap
@@ -28,6 +29,14 @@ def _valid_community_layout(layout):
 
 def info_json(keyboard):
     """Generate the info.json data for a specific keyboard.
+
+    The result is cached on disk, see qmk.info_cache.
+    """
+    return cached_info_json(keyboard, _generate_info_json)
+
+
+def _generate_info_json(keyboard):
+    """Resolve the info.json data for a keyboard from its info.json, config.h, rules.mk and C files.
     """
     cur_dir = Path('keyboards')
     root_rules_mk = parse_rules_mk_file(cur_dir / keyboard / 'rules.mk')
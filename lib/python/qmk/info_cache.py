@@ -0,0 +1,183 @@
+"""An on-disk cache for info_json().
+
+Every keyboard gets one entry in `.build/info_cache/`. It is keyed by a hash of every file that
+info_json() reads for that keyboard, plus the mappings, schemas and the python code doing the
+work, so there is nothing to invalidate by hand. `qmk clean` removes the cache along with the
+rest of the build directory.
+"""
+import json
+import logging
+import os
+import time
+from functools import lru_cache
+from glob import glob
+from hashlib import sha1
+from pathlib import Path
+from tempfile import NamedTemporaryFile
+
+from milc import cli
+
+from qmk.constants import BUILD_DIR
+from qmk.keyboard import resolve_keyboard
+
+CACHE_PATH = Path(BUILD_DIR) / 'info_cache'
+
+# Files used for every keyboard
+GLOBAL_FILES = [
+    'data/mappings/*',
+    'data/schemas/*',
+    'lib/python/qmk/*.py',
+]
+
+
+class CacheStats:
+    """Counts what the cache did in this process.
+    """
+    def __init__(self):
+        self.hits = 0
+        self.misses = 0
+        self.spent = 0.0
+        self.saved = 0.0
+
+    def snapshot(self):
+        return (self.hits, self.misses, self.spent, self.saved)
+
+    def add(self, hits, misses, spent, saved):
+        """Adds the counts of another process, see qmk.parallel.
+        """
+        self.hits += hits
+        self.misses += misses
+        self.spent += spent
+        self.saved += saved
+
+    def summary(self):
+        return f'info.json cache: {self.hits} hits, {self.misses} misses, {self.spent:.2f}s spent, {self.saved:.2f}s saved'
+
+
+stats = CacheStats()
+
+
+class _LogCapture(logging.Handler):
+    """Records what is logged while an entry is generated, so it can be repeated on a hit.
+    """
+    def __init__(self):
+        super().__init__()
+        self.records = []
+
+    def emit(self, record):
+        self.records.append([record.levelno, record.getMessage()])
+
+
+def _hash_file(digest, path):
+    digest.update(str(path).encode())
+    digest.update(b'\0')
+    try:
+        digest.update(Path(path).read_bytes())
+    except OSError:
+        digest.update(b'\0missing')
+
+
+@lru_cache(maxsize=None)
+def _global_digest():
+    """Hashes the files that are the same for all keyboards.
+    """
+    digest = sha1()
+    for pattern in GLOBAL_FILES:
+        for path in sorted(glob(pattern)):
+            _hash_file(digest, path)
+
+    # Only the presence of community layouts and their keymaps matters
+    for path in sorted(glob('layouts/default/*')) + sorted(glob('layouts/community/*/*/keymap.json')):
+        digest.update(path.encode() + b'\0')
+
+    return digest.digest()
+
+
+def _keyboard_dirs(keyboard):
+    """Returns every folder info_json() looks into for a keyboard, from the top down.
+    """
+    dirs = []
+    for name in (keyboard, resolve_keyboard(keyboard)):
+        current = Path('keyboards')
+        for part in Path(name).parts:
+            current = current / part
+            if current not in dirs:
+                dirs.append(current)
+    return dirs
+
+
+def cache_key(keyboard):
+    """Returns the hash of everything info_json() reads for `keyboard`.
+    """
+    digest = sha1(_global_digest())
+    digest.update(keyboard.encode())
+
+    for folder in _keyboard_dirs(keyboard):
+        try:
+            entries = sorted(os.scandir(folder), key=lambda entry: entry.name)
+        except OSError:
+            continue
+
+        for entry in entries:
+            if entry.is_file():
+                _hash_file(digest, entry.path)
+            elif entry.name == 'keymaps':
+                for keymap in sorted(glob(os.path.join(entry.path, '*', 'keymap.json'))):
+                    digest.update(keymap.encode() + b'\0')
+
+    return digest.hexdigest()
+
+
+def _cache_file(keyboard):
+    return CACHE_PATH / (keyboard.replace('/', '__') + '.json')
+
+
+def cached_info_json(keyboard, generate):
+    """Returns the info.json data for `keyboard`, calling `generate(keyboard)` only when it is not cached yet.
+    """
+    start = time.perf_counter()
+    key = cache_key(keyboard)
+    cache_file = _cache_file(keyboard)
+
+    try:
+        entry = json.loads(cache_file.read_text(encoding='utf-8'))
+        if entry['key'] == key:
+            for level, message in entry['log']:
+                cli.log.log(level, message)
+
+            elapsed = time.perf_counter() - start
+            stats.hits += 1
+            stats.spent += elapsed
+            stats.saved += max(entry['elapsed'] - elapsed, 0)
+            return entry['info']
+
+    except (OSError, ValueError, KeyError):
+        pass
+
+    capture = _LogCapture()
+    cli.log.addHandler(capture)
+    try:
+        info_data = generate(keyboard)
+    finally:
+        cli.log.removeHandler(capture)
+
+    elapsed = time.perf_counter() - start
+    stats.misses += 1
+    stats.spent += elapsed
+
+    try:
+        entry = json.dumps({'key': key, 'elapsed': elapsed, 'log': capture.records, 'info': info_data})
+    except (TypeError, ValueError) as e:
+        cli.log.debug('Could not cache the info.json data for %s: %s', keyboard, e)
+        return info_data
+
+    try:
+        CACHE_PATH.mkdir(parents=True, exist_ok=True)
+        with NamedTemporaryFile('w', encoding='utf-8', dir=CACHE_PATH, delete=False) as fd:
+            fd.write(entry)
+        os.replace(fd.name, cache_file)
+    except OSError as e:
+        cli.log.debug('Could not write %s: %s', cache_file, e)
+
+    # Hand out what a hit would, so the results do not depend on the state of the cache
+    return json.loads(entry)['info']
@@ -5,6 +5,12 @@ import re
 from string import Template
 from PIL import Image, ImageOps
 
+try:
+    import numpy
+except ImportError:
+    # Optional, only used to speed up the conversion of large images
+    numpy = None
+
 # The list of valid formats Quantum Painter supports
 valid_formats = {
     'pal256': {
@@ -161,6 +167,13 @@ def convert_requested_format(im, format):
     return im
 
 
+def _full_palette(im, ncolors):
+    """Returns the palette of the image, padded with black if it uses fewer than the requested number of colors.
+    """
+    pal = im.getpalette()
+    return pal + [0] * (ncolors * 3 - len(pal))
+
+
 def convert_image_bytes(im, format):
     """Convert the supplied image to the equivalent bytes required by the QMK firmware.
     """
@@ -173,6 +186,9 @@ def convert_image_bytes(im, format):
     (width, height) = im.size
     expected_byte_count = ((width * height) + (pixels_per_byte - 1)) // pixels_per_byte
 
+    if numpy is not None:
+        return _convert_image_bytes_numpy(im, format, expected_byte_count)
+
     if image_format == 'IMAGE_FORMAT_GRAYSCALE':
         # Take the red channel
         image_bytes = im.tobytes("raw", "R")
@@ -198,7 +214,7 @@ def convert_image_bytes(im, format):
 
         # Export the palette
         palette = []
-        pal = im.getpalette()
+        pal = _full_palette(im, ncolors)
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
@@ -218,7 +234,105 @@ def convert_image_bytes(im, format):
     return (palette, bytearray)
 
 
+def _convert_image_bytes_numpy(im, format, expected_byte_count):
+    """Same as convert_image_bytes(), working on all pixels at once.
+    """
+    ncolors = format["num_colors"]
+    bpp = int(math.log2(ncolors))
+    pixels_per_byte = 8 // bpp
+
+    if format["image_format"] == 'IMAGE_FORMAT_GRAYSCALE':
+        palette = None
+
+        # numpy.rint() rounds half to even, just like round()
+        pixels = numpy.frombuffer(im.tobytes("raw", "R"), dtype=numpy.uint8).astype(numpy.uint16)
+        pixels = numpy.rint(pixels * (ncolors - 1) / 255.0).astype(numpy.uint8)
+
+    else:
+        pal = _full_palette(im, ncolors)
+        palette = [(pal[n + 0], pal[n + 1], pal[n + 2]) for n in range(0, ncolors * 3, 3)]
+
+        pixels = numpy.frombuffer(im.tobytes("raw", "P"), dtype=numpy.uint8) & (ncolors - 1)
+
+    # Pad the last byte with zeros, then pack each group of pixels into one byte with the first pixel in the lowest bits
+    packed = numpy.zeros(expected_byte_count * pixels_per_byte, dtype=numpy.uint8)
+    packed[:len(pixels)] = pixels
+    packed = packed.reshape(-1, pixels_per_byte) << (numpy.arange(pixels_per_byte, dtype=numpy.uint8) * bpp)
+
+    return (palette, numpy.bitwise_or.reduce(packed, axis=1).tolist())
+
+
+def _compress_bytes_qmk_rle_numpy(bytearray):
+    """Same as compress_bytes_qmk_rle(), working on runs of equal bytes instead of one byte at a time.
+
+    A run of two or more bytes becomes a repeat block, split every 127 bytes. A byte left over after a split, and runs of
+    a single byte, go into the literal block, which is written out when it reaches 128 bytes or a repeat block starts.
+    """
+    data = numpy.asarray(bytearray, dtype=numpy.uint8)
+    starts = numpy.flatnonzero(numpy.diff(data, prepend=numpy.int16(data[0]) + 1))
+    lengths = numpy.diff(starts, append=len(data)).tolist()
+    values = data[starts].tolist()
+
+    output = []
+    literal = []
+    count = 0
+
+    def append_literal(b):
+        literal.append(b)
+        if len(literal) == 128:
+            output.append(255)
+            output.extend(literal)
+            literal.clear()
+
+    for value, length in zip(values, lengths):
+        count = 0
+        append_literal(value)
+        length -= 1
+
+        if length > 0 and not literal:
+            # The literal block was just written out, so this run starts over
+            literal.append(value)
+            length -= 1
+
+        if length == 0:
+            continue
+
+        # Two equal bytes start a repeat block, after writing out everything before them
+        if len(literal) > 1:
+            output.append(127 + len(literal) - 1)
+            output.extend(literal[:-1])
+        literal.clear()
+        length -= 1
+        count = 2
+
+        # Full repeat blocks carry one byte over, which starts the next block when followed by another one
+        while length > 0:
+            take = min(length, 126)
+            count += take
+            length -= take
+            if count == 128:
+                output += [127, value]
+                if length == 0:
+                    literal.append(value)
+                    count = 0
+                    break
+                length -= 1
+                count = 2
+
+        if count:
+            output += [count, value]
+
+    # The input ends with the last repeat block, or with whatever is in the literal block
+    if not count:
+        output.append(127 + len(literal))
+        output.extend(literal)
+    return output
+
+
 def compress_bytes_qmk_rle(bytearray):
+    if numpy is not None and len(bytearray) > 0:
+        return _compress_bytes_qmk_rle_numpy(bytearray)
+
     debug_dump = False
     output = []
     temp = []
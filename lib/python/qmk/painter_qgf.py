@@ -5,12 +5,19 @@
 # See https://docs.qmk.fm/#/quantum_painter_qgf for more information.
 
 from colorsys import rgb_to_hsv
+from io import BytesIO
 from types import FunctionType
-from PIL import Image, ImageFile, ImageChops
+from PIL import Image, ImageFile, ImageChops, ImageOps
 from PIL._binary import o8, o16le as o16, o32le as o32
 import qmk.painter
 
 
+# Estimated cost of drawing a frame on the device, in bytes of flash, used to choose between encodings of a similar size.
+# Every pixel of a frame has to be sent to the display, and decoding RLE adds a little work for each byte read.
+DECODE_COST_PER_PIXEL = 1 / 32
+DECODE_COST_PER_RLE_BYTE = 1 / 8
+
+
 def o24(i):
     return o16(i & 0xFFFF) + o8((i & 0xFF0000) >> 16)
 
@@ -221,6 +228,20 @@ def _accept(prefix):
     return False
 
 
+def _changed_bbox(frame, last_frame, format):
+    """Helper to find the area of a frame that differs from the last frame.
+
+    Grayscale frames are compared after reducing them to the requested number of shades, so changes that do not survive
+    the conversion are not drawn. Palettes are worked out per frame, so those are compared as they are.
+    """
+    if format['image_format'] == 'IMAGE_FORMAT_GRAYSCALE':
+        shades = format['num_colors'] - 1
+        frame = ImageOps.grayscale(frame).point(lambda val: qmk.painter.rescale_byte(val, shades))
+        last_frame = ImageOps.grayscale(last_frame).point(lambda val: qmk.painter.rescale_byte(val, shades))
+
+    return ImageChops.difference(frame, last_frame).getbbox()
+
+
 def _save(im, fp, filename):
     """Helper method used by PIL to write to an output file.
     """
@@ -230,6 +251,10 @@ def _save(im, fp, filename):
     verbose = encoderinfo.get("verbose", False)
     use_deltas = encoderinfo.get("use_deltas", True)
     use_rle = encoderinfo.get("use_rle", True)
+    use_dedupe = encoderinfo.get("use_dedupe", True)
+
+    # Work out the format we're going to use
+    format = encoderinfo["qmk_format"]
 
     # Helper for inline verbose prints
     def vprint(s):
@@ -276,114 +301,92 @@ def _save(im, fp, filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
-    # Helper function to save each frame to the output file
-    def _write_frame(idx, frame, last_frame):
-        # If we replace the frame we're going to output with a delta, we can override it here
-        this_frame = frame
-        location = (0, 0)
-        size = frame.size
-
-        # Work out the format we're going to use
-        format = encoderinfo["qmk_format"]
+    # Frames already written to the output, so that frames which encode to the same bytes can share them
+    written_frames = {}
 
-        # Convert the original frame so we can do comparisons
-        converted = qmk.painter.convert_requested_format(this_frame, format)
-        graphic_data = qmk.painter.convert_image_bytes(converted, format)
+    # Helper to encode an area of a frame, either the whole frame or a delta, in every compression scheme allowed
+    def _encode_frame(frame, bbox):
+        image = frame.crop(bbox) if bbox else frame
+        converted = qmk.painter.convert_requested_format(image, format)
+        palette, raw_data = qmk.painter.convert_image_bytes(converted, format)
 
-        # Convert the raw data to RLE-encoded if requested
-        raw_data = graphic_data[1]
+        candidates = [(0x00, raw_data)]  # See qp.h, painter_compression_t
         if use_rle:
-            rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
-        use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
-        image_data = raw_data if use_raw_this_frame else rle_data
+            candidates.append((0x01, qmk.painter.compress_bytes_qmk_rle(raw_data)))
+
+        pixel_count = image.size[0] * image.size[1]
+        for compression, image_data in candidates:
+            out = BytesIO()
+
+            # Write out the frame descriptor
+            frame_descriptor = QGFFrameDescriptorV1()
+            frame_descriptor.is_delta = bbox is not None
+            frame_descriptor.is_transparent = False
+            frame_descriptor.format = format['image_format_byte']
+            frame_descriptor.compression = compression
+            frame_descriptor.delay = frame.info['duration'] if 'duration' in frame.info else 1000  # If we're not an animation, just pretend we're delaying for 1000ms
+            frame_descriptor.write(out)
+
+            # Write out the palette if required
+            if format['has_palette']:
+                palette_descriptor = QGFFramePaletteDescriptorV1()
+
+                # Helper to convert from RGB888 to the QMK "dialect" of HSV888
+                def rgb888_to_qmk_hsv888(e):
+                    hsv = rgb_to_hsv(e[0] / 255.0, e[1] / 255.0, e[2] / 255.0)
+                    return (int(hsv[0] * 255.0), int(hsv[1] * 255.0), int(hsv[2] * 255.0))
+
+                # Convert all palette entries to HSV888 and write to the output
+                palette_descriptor.palette_entries = list(map(rgb888_to_qmk_hsv888, palette))
+                palette_descriptor.write(out)
+
+            # Write out the delta info if required
+            if bbox:
+                # Set up the rendering location of where the delta frame should be situated
+                delta_descriptor = QGFFrameDeltaDescriptorV1()
+                delta_descriptor.left, delta_descriptor.top, delta_descriptor.right, delta_descriptor.bottom = bbox
+                delta_descriptor.write(out)
+
+            # Write out the data for this frame
+            data_descriptor = QGFFrameDataDescriptorV1()
+            data_descriptor.data = image_data
+            data_descriptor.write(out)
+
+            decode_cost = pixel_count * DECODE_COST_PER_PIXEL
+            if compression == 0x01:
+                decode_cost += len(image_data) * DECODE_COST_PER_RLE_BYTE
+
+            description = f'{"delta" if bbox else "full"} {"rle" if compression else "raw"} {image.size[0]}x{image.size[1]}'
+            yield out.getvalue(), decode_cost, description
 
-        # Work out if a delta frame is smaller than injecting it directly
-        use_delta_this_frame = False
+    # Helper function to save each frame to the output file
+    def _write_frame(idx, frame, last_frame):
+        # Try the whole frame, and if we want to use deltas, the area that changed since the last frame
+        encodings = list(_encode_frame(frame, None))
         if use_deltas and last_frame is not None:
-            # If we want to use deltas, then find the difference
-            diff = ImageChops.difference(frame, last_frame)
+            # If nothing changed, redraw a single pixel so that the frame still gets its own delay
+            bbox = _changed_bbox(frame, last_frame, format) or (0, 0, 1, 1)
+            encodings.extend(_encode_frame(frame, bbox))
 
-            # Get the bounding box of those differences
-            bbox = diff.getbbox()
+        # Pick whichever is cheapest in flash plus decode time; frames that are already in the output are free in flash.
+        # On a tie the earlier candidate wins, so raw data is preferred over RLE, and whole frames over deltas.
+        def _cost(encoding):
+            frame_bytes, decode_cost, _ = encoding
+            flash_cost = 0 if use_dedupe and frame_bytes in written_frames else len(frame_bytes)
+            return flash_cost + decode_cost
 
-            # If we have a valid bounding box...
-            if bbox:
-                # ...create the delta frame by cropping the original.
-                delta_frame = frame.crop(bbox)
-                delta_location = (bbox[0], bbox[1])
-                delta_size = (bbox[2] - bbox[0], bbox[3] - bbox[1])
-
-                # Convert the delta frame to the requested format
-                delta_converted = qmk.painter.convert_requested_format(delta_frame, format)
-                delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format)
-
-                # Work out how large the delta frame is going to be with compression etc.
-                delta_raw_data = delta_graphic_data[1]
-                if use_rle:
-                    delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
-                delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
-                delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
-
-                # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
-                # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
-                # sizing constraints.
-                if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
-                    # Copy across all the delta equivalents so that the rest of the processing acts on those
-                    this_frame = delta_frame
-                    location = delta_location
-                    size = delta_size
-                    converted = delta_converted
-                    graphic_data = delta_graphic_data
-                    raw_data = delta_raw_data
-                    rle_data = delta_rle_data
-                    use_raw_this_frame = delta_use_raw_this_frame
-                    image_data = delta_image_data
-                    use_delta_this_frame = True
-
-        # Write out the frame descriptor
+        frame_bytes, _, description = min(encodings, key=_cost)
+
+        if use_dedupe and frame_bytes in written_frames:
+            frame_offsets.frame_offsets[idx] = written_frames[frame_bytes]
+            vprint(f'{f"Frame {idx:3d} reused":26s} {written_frames[frame_bytes]:5d}d / {written_frames[frame_bytes]:04X}h ({description})')
+            return
+
+        # Write out the frame to the output
         frame_offsets.frame_offsets[idx] = fp.tell()
-        vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
-        frame_descriptor = QGFFrameDescriptorV1()
-        frame_descriptor.is_delta = use_delta_this_frame
-        frame_descriptor.is_transparent = False
-        frame_descriptor.format = format['image_format_byte']
-        frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
-        frame_descriptor.delay = frame.info['duration'] if 'duration' in frame.info else 1000  # If we're not an animation, just pretend we're delaying for 1000ms
-        frame_descriptor.write(fp)
-
-        # Write out the palette if required
-        if format['has_palette']:
-            palette = graphic_data[0]
-            palette_descriptor = QGFFramePaletteDescriptorV1()
-
-            # Helper to convert from RGB888 to the QMK "dialect" of HSV888
-            def rgb888_to_qmk_hsv888(e):
-                hsv = rgb_to_hsv(e[0] / 255.0, e[1] / 255.0, e[2] / 255.0)
-                return (int(hsv[0] * 255.0), int(hsv[1] * 255.0), int(hsv[2] * 255.0))
-
-            # Convert all palette entries to HSV888 and write to the output
-            palette_descriptor.palette_entries = list(map(rgb888_to_qmk_hsv888, palette))
-            vprint(f'{f"Frame {idx:3d} palette":26s} {fp.tell():5d}d / {fp.tell():04X}h')
-            palette_descriptor.write(fp)
-
-        # Write out the delta info if required
-        if use_delta_this_frame:
-            # Set up the rendering location of where the delta frame should be situated
-            delta_descriptor = QGFFrameDeltaDescriptorV1()
-            delta_descriptor.left = location[0]
-            delta_descriptor.top = location[1]
-            delta_descriptor.right = location[0] + size[0]
-            delta_descriptor.bottom = location[1] + size[1]
-
-            # Write the delta frame to the output
-            vprint(f'{f"Frame {idx:3d} delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
-            delta_descriptor.write(fp)
-
-        # Write out the data for this frame to the output
-        data_descriptor = QGFFrameDataDescriptorV1()
-        data_descriptor.data = image_data
-        vprint(f'{f"Frame {idx:3d} data":26s} {fp.tell():5d}d / {fp.tell():04X}h')
-        data_descriptor.write(fp)
+        written_frames[frame_bytes] = fp.tell()
+        vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h ({description}, {len(frame_bytes)} bytes)')
+        fp.write(frame_bytes)
 
     # Iterate over each if the input frames, writing it to the output in the process
     _for_all_frames(_write_frame)
@@ -0,0 +1,70 @@
+"""Run per-keyboard work in a pool of processes.
+"""
+import os
+from multiprocessing import get_all_start_methods, get_context
+
+from milc import cli
+
+from qmk.info_cache import stats as info_cache_stats
+
+# How often progress is logged, in percent
+PROGRESS_STEP = 10
+
+
+def _run(job):
+    """Runs in a worker. Also hands back what the info.json cache did, so the parent can report it.
+    """
+    func, index, item = job
+    before = info_cache_stats.snapshot()
+    result = func(item)
+    after = info_cache_stats.snapshot()
+
+    return index, result, [now - then for now, then in zip(after, before)]
+
+
+def parallel_map(func, items, jobs=1, what='keyboards'):
+    """Calls `func` for every entry in `items` and returns the results in the same order as `items`.
+
+    Workers are forked, so they see the parsed arguments and configuration of the command, and share the on-disk info.json cache. Whatever they log goes straight to the console.
+
+    Args:
+
+        func
+            A module level function taking one item
+
+        items
+            The items to work on
+
+        jobs
+            The number of processes to use; 0 means one per CPU
+
+        what
+            What the items are, for the progress messages
+    """
+    items = list(items)
+    jobs = int(jobs) if int(jobs) > 0 else os.cpu_count() or 1
+
+    if 'fork' not in get_all_start_methods():
+        cli.log.debug('Processes can not be forked on this platform, running serially.')
+        jobs = 1
+
+    jobs = min(jobs, len(items))
+    if jobs <= 1:
+        return [func(item) for item in items]
+
+    results = [None] * len(items)
+    reported = 0
+
+    with get_context('fork').Pool(jobs) as pool:
+        work = pool.imap_unordered(_run, ((func, index, item) for index, item in enumerate(items)))
+
+        for done, (index, result, cache_stats) in enumerate(work, 1):
+            results[index] = result
+            info_cache_stats.add(*cache_stats)
+
+            percent = done * 100 // len(items)
+            if percent >= reported + PROGRESS_STEP or done == len(items):
+                reported = percent - percent % PROGRESS_STEP
+                cli.log.info('Processed %d/%d %s (%d%%)', done, len(items), what, percent)
+
+    return results
@@ -1,5 +1,7 @@
 import platform
+from pathlib import Path
 from subprocess import DEVNULL
+from tempfile import TemporaryDirectory
 
 from milc import cli
 
@@ -282,6 +284,24 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_keyboard_files():
+    with TemporaryDirectory() as output:
+        result = check_subcommand('generate-keyboard-files', '-kb', 'handwired/pytest/basic', '-o', output)
+        check_returncode(result)
+        assert 'MCU ?= atmega32u4' in (Path(output) / 'info_rules.mk').read_text()
+        assert '#   define MATRIX_ROW_PINS { F5 }' in (Path(output) / 'info_config.h').read_text()
+        assert '#define LAYOUT_custom(k0A) {' in (Path(output) / 'layouts.h').read_text()
+        assert (Path(output) / 'default_keyboard.c').exists()
+        assert (Path(output) / 'default_keyboard.h').exists()
+
+        # Unchanged files are left alone
+        mtime = (Path(output) / 'info_config.h').stat().st_mtime_ns
+        result = check_subcommand('generate-keyboard-files', '-kb', 'handwired/pytest/basic', '-o', output)
+        check_returncode(result)
+        assert 'info_config.h' not in result.stdout
+        assert (Path(output) / 'info_config.h').stat().st_mtime_ns == mtime
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
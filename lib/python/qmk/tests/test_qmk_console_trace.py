@@ -0,0 +1,35 @@
+import struct
+
+from qmk.console_trace import TraceDecoder, format_c
+
+formats = b'row %u: %d\n\0key %s\0'
+
+
+def format_record(fmt_id, *args):
+    return struct.pack('<BH%dI' % len(args), 0x80 | len(args), fmt_id, *(arg & 0xFFFFFFFF for arg in args))
+
+
+def test_format_c():
+    assert format_c('%u %d %hd %hhu', [1, -1 & 0xFFFFFFFF, 0xFFFF, 0x1FF]) == '1 -1 -1 255'
+    assert format_c('%02X %04x %lX', [0xA, 0xBEEF, 0x12345678]) == '0A beef 12345678'
+    assert format_c('%08b %c %%', [5, 65]) == '00000101 A %'
+
+
+def test_format_c_strings():
+    assert format_c('%s', [0x100], {0x100: 'layer'}.get) == 'layer'
+    assert format_c('%s', [0x200], {0x100: 'layer'}.get) == '<0x00000200>'
+
+
+def test_decode():
+    decoder = TraceDecoder(formats)
+    stream = format_record(0, 3, -2) + b'\x43ab\n' + b'\x01\x09\x00' + b'\0' * 8
+
+    assert decoder.feed(stream) == 'row 3: -2\nab\n[9 console messages dropped]\n'
+
+
+def test_decode_split_records():
+    decoder = TraceDecoder(formats, {0x1234: 'A'}.get)
+    stream = format_record(12, 0x1234) + b'\x41\n'
+
+    assert decoder.feed(stream[:4]) == ''
+    assert decoder.feed(stream[4:]) == 'key A\n'
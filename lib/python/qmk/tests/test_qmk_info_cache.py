@@ -0,0 +1,37 @@
+from pathlib import Path
+from tempfile import TemporaryDirectory
+
+from milc import cli
+
+import qmk.info_cache
+
+
+class Generator:
+    def __init__(self):
+        self.calls = 0
+
+    def __call__(self, keyboard):
+        self.calls += 1
+        cli.log.warning('%s: generated', keyboard)
+        return {'keyboard_folder': keyboard, 'matrix_size': {'cols': 1, 'rows': 1}}
+
+
+def test_cache_key_pytest_basic():
+    key = qmk.info_cache.cache_key('handwired/pytest/basic')
+    assert key == qmk.info_cache.cache_key('handwired/pytest/basic')
+    assert key != qmk.info_cache.cache_key('handwired/pytest/has_template')
+
+
+def test_cached_info_json():
+    cache_path = qmk.info_cache.CACHE_PATH
+    with TemporaryDirectory() as tmp:
+        qmk.info_cache.CACHE_PATH = Path(tmp)
+        try:
+            generate = Generator()
+            first = qmk.info_cache.cached_info_json('handwired/pytest/basic', generate)
+            second = qmk.info_cache.cached_info_json('handwired/pytest/basic', generate)
+        finally:
+            qmk.info_cache.CACHE_PATH = cache_path
+
+    assert generate.calls == 1
+    assert first == second == {'keyboard_folder': 'handwired/pytest/basic', 'matrix_size': {'cols': 1, 'rows': 1}}
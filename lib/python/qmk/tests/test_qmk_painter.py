@@ -0,0 +1,87 @@
+import io
+import random
+import struct
+
+from PIL import Image, ImageDraw
+
+import qmk.painter
+import qmk.painter_qgf  # noqa: F401, registers the QGF image format
+
+
+def make_image():
+    # Enough colors to fill every palette, and an odd number of pixels
+    size = (63, 33)
+    im = Image.merge('RGB', (Image.linear_gradient('L').resize(size), Image.radial_gradient('L').resize(size), Image.linear_gradient('L').rotate(90).resize(size)))
+    draw = ImageDraw.Draw(im)
+    draw.ellipse((3, 2, 20, 15), fill=(255, 0, 128))
+    draw.rectangle((22, 0, 30, 8), fill=(0, 200, 40))
+    return im
+
+
+def without_numpy(func, *args):
+    numpy = qmk.painter.numpy
+    qmk.painter.numpy = None
+    try:
+        return func(*args)
+    finally:
+        qmk.painter.numpy = numpy
+
+
+def test_convert_image_bytes():
+    for format in qmk.painter.valid_formats.values():
+        if format['image_format'] not in ('IMAGE_FORMAT_GRAYSCALE', 'IMAGE_FORMAT_PALETTE'):
+            continue
+        im = qmk.painter.convert_requested_format(make_image(), format)
+        assert qmk.painter.convert_image_bytes(im, format) == without_numpy(qmk.painter.convert_image_bytes, im, format)
+
+
+def test_compress_bytes_qmk_rle():
+    rng = random.Random(1)
+    cases = [[0], [1, 1], [2] * 127, [3] * 128, [4] * 129, [5] * 255, [6] * 256, list(range(128)), list(range(129)) + [9] * 130]
+    for _ in range(200):
+        data = []
+        while len(data) < 400:
+            data += [rng.randrange(4)] * rng.choice([1, 1, 2, 3, 126, 127, 128, 129])
+        cases.append(data)
+
+    for data in cases:
+        assert qmk.painter.compress_bytes_qmk_rle(data) == without_numpy(qmk.painter.compress_bytes_qmk_rle, data)
+
+
+def test_save_qgf():
+    frames = [make_image().rotate(angle) for angle in (0, 90, 180)]
+
+    def save():
+        output = io.BytesIO()
+        frames[0].save(output, 'QGF', append_images=frames[1:], use_deltas=True, use_rle=True, qmk_format=qmk.painter.valid_formats['mono16'], verbose=False)
+        return output.getvalue()
+
+    assert save() == without_numpy(save)
+
+
+def save_qgf_frame_offsets(frames, format, **options):
+    output = io.BytesIO()
+    frames[0].save(output, 'QGF', append_images=frames[1:], qmk_format=qmk.painter.valid_formats[format], verbose=False, **options)
+    return list(struct.unpack_from(f'<{len(frames)}I', output.getvalue(), 28))
+
+
+def test_save_qgf_dedupe():
+    frames = [make_image(), make_image().rotate(90), make_image(), make_image()]
+
+    # The third frame redraws the first, and the fourth did not change so only redraws a pixel of the third
+    offsets = save_qgf_frame_offsets(frames, 'pal16')
+    assert offsets[2] == offsets[0]
+    assert offsets[3] not in offsets[:3]
+
+    offsets = save_qgf_frame_offsets(frames[:3], 'pal16', use_dedupe=False)
+    assert len(set(offsets)) == 3
+
+
+def test_save_qgf_grayscale_delta():
+    # A change too small to survive the conversion to two shades is not drawn
+    frames = [Image.new('RGB', (32, 32)), Image.new('RGB', (32, 32), (1, 1, 1)), Image.new('RGB', (32, 32), (1, 1, 1))]
+    frames[1].info['duration'] = frames[2].info['duration'] = 100
+
+    offsets = save_qgf_frame_offsets(frames, 'mono2')
+    assert offsets[2] == offsets[1]
+    assert offsets[1] - offsets[0] < 40
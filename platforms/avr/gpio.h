@@ -36,3 +36,12 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define togglePin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t port_t;
+typedef uint8_t port_data_t;
+
+#define getPinPort(pin) ((pin) >> PORT_SHIFTER)
+#define getPinBit(pin) ((pin)&0xF)
+#define readPort(port) _SFR_IO8(ADDRESS_BASE + (port))
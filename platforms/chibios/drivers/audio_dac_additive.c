@@ -81,6 +81,54 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer_empty[AUDIO_DAC_BUFFER_SIZE] = {AUDIO_DAC_OFF_VALUE};
 
+#ifdef AUDIO_DAC_FIXED_POINT
+/* fixed-point engine: phase increments are computed once per tone change, and
+ * samples are rendered with integer math only - see quantum/audio/wavetable_synth.h
+ */
+#    include "wavetable_synth.h"
+
+_Static_assert(WAVETABLE_SYNTH_TABLE_SIZE == AUDIO_DAC_BUFFER_SIZE, "the fixed point engine plays the AUDIO_DAC_BUFFER_SIZE sample tables, WAVETABLE_SYNTH_TABLE_SIZE has to match");
+
+#    if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#        define DAC_WAVETABLE dac_buffer_sine
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#        define DAC_WAVETABLE dac_buffer_triangle
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#        define DAC_WAVETABLE dac_buffer_trapezoid
+#    elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#        define DAC_WAVETABLE dac_buffer_square
+#    endif
+
+/* the gpt timer runs with 3*AUDIO_DAC_SAMPLE_RATE and the DAC callback is called
+ * twice per conversion, which works out to a sample rate of 3/2*AUDIO_DAC_SAMPLE_RATE
+ * (see the 2/3 correction in dac_value_generate below)
+ */
+#    define DAC_SYNTH_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3.0f / 2.0f)
+
+static wavetable_synth_t dac_synth;
+
+#    ifdef WAVETABLE_SYNTH_ENVELOPE
+#        ifndef WAVETABLE_SYNTH_ENVELOPE_ATTACK
+#            define WAVETABLE_SYNTH_ENVELOPE_ATTACK 64
+#        endif
+#        ifndef WAVETABLE_SYNTH_ENVELOPE_DECAY
+#            define WAVETABLE_SYNTH_ENVELOPE_DECAY 512
+#        endif
+#        ifndef WAVETABLE_SYNTH_ENVELOPE_SUSTAIN
+#            define WAVETABLE_SYNTH_ENVELOPE_SUSTAIN 0xC000
+#        endif
+#        ifndef WAVETABLE_SYNTH_ENVELOPE_RELEASE
+#            define WAVETABLE_SYNTH_ENVELOPE_RELEASE 0
+#        endif
+static const wavetable_envelope_t dac_envelope = {
+    .attack  = WAVETABLE_SYNTH_ENVELOPE_ATTACK,
+    .decay   = WAVETABLE_SYNTH_ENVELOPE_DECAY,
+    .sustain = WAVETABLE_SYNTH_ENVELOPE_SUSTAIN,
+    .release = WAVETABLE_SYNTH_ENVELOPE_RELEASE,
+};
+#    endif
+#endif // AUDIO_DAC_FIXED_POINT
+
 /* keep track of the sample position for for each frequency */
 static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
 
@@ -108,6 +156,11 @@ output_states_t state = OUTPUT_OFF_2;
  * can override it with their own wave-forms/noises.
  */
 __attribute__((weak)) uint16_t dac_value_generate(void) {
+#ifdef AUDIO_DAC_FIXED_POINT
+    // released voices keep sounding during a pause until their envelope has faded out,
+    // without any voices left this is AUDIO_DAC_OFF_VALUE
+    return wavetable_synth_next(&dac_synth);
+#else
     // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
     if (active_tones_snapshot_length == 0) {
         return AUDIO_DAC_OFF_VALUE;
@@ -159,6 +212,7 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     return value;
+#endif // AUDIO_DAC_FIXED_POINT
 }
 
 /**
@@ -224,9 +278,26 @@ static void dac_end(DACDriver *dacp) {
                     active_tones_snapshot[active_tones_snapshot_length++] = freq;
                 }
             }
+#ifdef AUDIO_DAC_FIXED_POINT
+#    ifdef WAVETABLE_SYNTH_ENVELOPE
+            if (0 == active_tones_snapshot_length) {
+                // let the playing voices fade out, instead of cutting them off
+                wavetable_synth_release(&dac_synth);
+            } else
+#    endif
+            {
+                wavetable_synth_set_voices(&dac_synth, active_tones_snapshot, active_tones_snapshot_length, DAC_SYNTH_SAMPLE_RATE);
+            }
+#endif
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
-                state = OUTPUT_OFF;
+#ifdef AUDIO_DAC_FIXED_POINT
+                // stays in OUTPUT_REACHED_ZERO_BEFORE_OFF, and so comes back here, until the release is over
+                if (!wavetable_synth_is_playing(&dac_synth))
+#endif
+                {
+                    state = OUTPUT_OFF;
+                }
             }
             if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
                 state = OUTPUT_RUN_NORMALLY;
@@ -333,5 +404,11 @@ void audio_driver_start(void) {
         active_tones_snapshot[i] = 0.0f;
     }
     active_tones_snapshot_length = 0;
-    state                        = OUTPUT_SHOULD_START;
+#ifdef AUDIO_DAC_FIXED_POINT
+    wavetable_synth_init(&dac_synth, DAC_WAVETABLE, AUDIO_DAC_OFF_VALUE);
+#    ifdef WAVETABLE_SYNTH_ENVELOPE
+    wavetable_synth_set_envelope(&dac_synth, &dac_envelope);
+#    endif
+#endif
+    state = OUTPUT_SHOULD_START;
 }
@@ -1,15 +1,10 @@
 #include "ws2812.h"
+#include "ws2812_encode.h"
 #include "quantum.h"
 #include <hal.h>
 
 /* Adapted from https://github.com/joewa/WS2812-LED-Driver_ChibiOS/ */
 
-#ifdef RGBW
-#    define WS2812_CHANNELS 4
-#else
-#    define WS2812_CHANNELS 3
-#endif
-
 #ifndef WS2812_PWM_DRIVER
 #    define WS2812_PWM_DRIVER PWMD2 // TIMx
 #endif
@@ -249,6 +244,11 @@
 
 static uint32_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
 
+/**
+ * @brief   Duty cycles indexed by the value of a color bit, so encoding a frame needs no per-bit branches
+ */
+static const uint32_t ws2812_duty_cycle[2] = {WS2812_DUTYCYCLE_0, WS2812_DUTYCYCLE_1};
+
 /* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 /*
  * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
@@ -310,19 +310,19 @@ void ws2812_init(void) {
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ws2812_duty_cycle[(r >> bit) & 0x01];
+        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ws2812_duty_cycle[(g >> bit) & 0x01];
+        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ws2812_duty_cycle[(b >> bit) & 0x01];
     }
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
     // Write color to frame buffer
     for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ws2812_duty_cycle[(r >> bit) & 0x01];
+        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ws2812_duty_cycle[(g >> bit) & 0x01];
+        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ws2812_duty_cycle[(b >> bit) & 0x01];
 #ifdef RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ws2812_duty_cycle[(w >> bit) & 0x01];
 #endif
     }
 }
@@ -336,10 +336,12 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     }
 
     for (uint16_t i = 0; i < leds; i++) {
-#ifdef RGBW
-        ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
-#else
-        ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
-#endif
+        uint8_t bytes[WS2812_CHANNELS];
+        ws2812_encode_color(bytes, ledarray[i]);
+        for (uint8_t byte = 0; byte < WS2812_CHANNELS; byte++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                ws2812_frame_buffer[WS2812_BIT(i, byte, bit)] = ws2812_duty_cycle[(bytes[byte] >> bit) & 0x01];
+            }
+        }
     }
 }
@@ -1,5 +1,6 @@
 #include "quantum.h"
 #include "ws2812.h"
+#include "ws2812_encode.h"
 
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
@@ -69,67 +70,54 @@
 #    define WS2812_SCK_OUTPUT_MODE PAL_MODE_ALTERNATE(WS2812_SPI_SCK_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL
 #endif
 
-#define BYTES_FOR_LED_BYTE 4
-#ifdef RGBW
-#    define WS2812_CHANNELS 4
-#else
-#    define WS2812_CHANNELS 3
+#if defined(WS2812_SPI_DOUBLE_BUFFER) && (defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC))
+#    error "WS2812_SPI_DOUBLE_BUFFER cannot be used together with WS2812_SPI_USE_CIRCULAR_BUFFER or WS2812_SPI_SYNC"
 #endif
-#define BYTES_FOR_LED (BYTES_FOR_LED_BYTE * WS2812_CHANNELS)
+
+#define BYTES_FOR_LED WS2812_STREAM_BYTES_PER_LED
 #define DATA_SIZE (BYTES_FOR_LED * RGBLED_NUM)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+/*
+ * While one buffer is being clocked out by the DMA, the next frame is encoded into
+ * the other one. A frame that is ready while a transfer is still running is queued,
+ * and started from the SPI end callback, so ws2812_setleds never waits for the bus.
+ */
+static uint8_t  txbuf_a[TXBUF_SIZE] = {0};
+static uint8_t  txbuf_b[TXBUF_SIZE] = {0};
+static uint8_t* txbuf_active        = txbuf_a;
+static uint8_t* txbuf_pending       = NULL;
+static uint8_t* txbuf               = txbuf_b;
+#else
+static uint8_t txbuf[TXBUF_SIZE] = {0};
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, every LED is sent in the bit stream form produced by
+ * ws2812_encode_stream_led.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+static void set_led_color_rgb(LED_TYPE color, int pos) {
+    ws2812_encode_stream_led(&txbuf[PREAMBLE_SIZE + BYTES_FOR_LED * pos], color);
 }
 
-static void set_led_color_rgb(LED_TYPE color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
-
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
-#endif
-#ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
-#endif
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    chSysLockFromISR();
+    if (txbuf_pending) {
+        txbuf_active  = txbuf_pending;
+        txbuf_pending = NULL;
+        spiStartSendI(spip, TXBUF_SIZE, txbuf_active);
+    }
+    chSysUnlockFromISR();
 }
+#    define WS2812_SPI_END_CB ws2812_spi_end_cb
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
 
 void ws2812_init(void) {
     palSetLineMode(RGB_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
@@ -145,7 +133,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(RGB_DI_PIN),
         PAL_PAD(RGB_DI_PIN),
         WS2812_SPI_DIVISOR_CR1_BR_X,
@@ -158,8 +146,8 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
-        NULL, // error_cb
+        WS2812_SPI_END_CB, // data_cb
+        NULL,              // error_cb
         PAL_PORT(RGB_DI_PIN),
         PAL_PAD(RGB_DI_PIN),
         WS2812_SPI_DIVISOR_CR1_BR_X,
@@ -171,7 +159,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiStartSend(&WS2812_SPI, TXBUF_SIZE, txbuf);
 #endif
 }
 
@@ -182,6 +170,14 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    // encode into whichever buffer is not on the wire - reclaiming a queued frame that has not started yet
+    chSysLock();
+    txbuf         = txbuf_pending ? txbuf_pending : (txbuf_active == txbuf_a ? txbuf_b : txbuf_a);
+    txbuf_pending = NULL;
+    chSysUnlock();
+#endif
+
     for (uint8_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
@@ -189,10 +185,19 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+#    if defined(WS2812_SPI_SYNC)
+    spiSend(&WS2812_SPI, TXBUF_SIZE, txbuf);
+#    elif defined(WS2812_SPI_DOUBLE_BUFFER)
+    chSysLock();
+    if (WS2812_SPI.state == SPI_READY) {
+        txbuf_active = txbuf;
+        spiStartSendI(&WS2812_SPI, TXBUF_SIZE, txbuf_active);
+    } else {
+        txbuf_pending = txbuf;
+    }
+    chSysUnlock();
 #    else
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiStartSend(&WS2812_SPI, TXBUF_SIZE, txbuf);
 #    endif
 #endif
 }
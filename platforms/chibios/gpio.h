@@ -43,3 +43,12 @@ typedef ioline_t pin_t;
 #define readPin(pin) palReadLine(pin)
 
 #define togglePin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportid_t   port_t;
+typedef ioportmask_t port_data_t;
+
+#define getPinPort(pin) PAL_PORT(pin)
+#define getPinBit(pin) PAL_PAD(pin)
+#define readPort(port) palReadPort(port)
@@ -59,7 +59,7 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef FLASH_STM32_MOCKED
 // Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+#        define TOTAL_EEPROM_BYTE_COUNT 512
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_stm32_tests.h"
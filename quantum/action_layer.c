@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -322,27 +323,74 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
+#if defined(LAYER_RESOLUTION_CACHE) && !defined(NO_ACTION_LAYER)
+#    define RESOLVED_LAYER_UNKNOWN 0xFF
+
+/** \brief resolved layer cache
+ *
+ * Topmost non-transparent layer of each matrix position, for the layers in resolved_layer_cache_state
+ */
+static uint8_t       resolved_layer_cache[MATRIX_ROWS * MATRIX_COLS];
+static layer_state_t resolved_layer_cache_state;
+static bool          resolved_layer_cache_valid = false;
+
+/** \brief clear resolved layer cache
+ *
+ * Has to be called whenever the keymap contents change, e.g. on dynamic keymap writes.
+ * Layer state changes are picked up on their own.
+ */
+void layer_resolution_cache_clear(void) {
+    resolved_layer_cache_valid = false;
+}
+
+/** \brief resolved layer cache entry
+ *
+ * Returns the cache entry of a key for the given layers, or NULL for keys outside of the matrix
+ */
+static uint8_t *resolved_layer_cache_entry(keypos_t key, layer_state_t layers) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+    if (!resolved_layer_cache_valid || resolved_layer_cache_state != layers) {
+        memset(resolved_layer_cache, RESOLVED_LAYER_UNKNOWN, sizeof(resolved_layer_cache));
+        resolved_layer_cache_state = layers;
+        resolved_layer_cache_valid = true;
+    }
+    return &resolved_layer_cache[key.row * MATRIX_COLS + key.col];
+}
+#endif
+
 /** \brief Layer switch get layer
  *
  * Gets the layer based on key info
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
     layer_state_t layers = layer_state | default_layer_state;
+    uint8_t       layer  = 0; /* fall back to layer 0 */
+
+#    ifdef LAYER_RESOLUTION_CACHE
+    uint8_t *cached = resolved_layer_cache_entry(key, layers);
+    if (cached && *cached != RESOLVED_LAYER_UNKNOWN) {
+        return *cached;
+    }
+#    endif
+
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
-        if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
-            }
+        /* only KC_TRANSPARENT decodes to ACTION_TRANSPARENT, so the full action lookup can be skipped */
+        if ((layers & ((layer_state_t)1 << i)) && keymap_key_to_keycode(i, key) != KC_TRANSPARENT) {
+            layer = i;
+            break;
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+
+#    ifdef LAYER_RESOLUTION_CACHE
+    if (cached) {
+        *cached = layer;
+    }
+#    endif
+    return layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -117,6 +117,14 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Checks whether a tap-hold key is still being resolved
+ *
+ * \return true while there is a tapping key or buffered key events
+ */
+bool action_tapping_is_pending(void) {
+    return IS_TAPPING() || waiting_buffer_head != waiting_buffer_tail;
+}
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -0,0 +1,5 @@
+wavetable_synth_DEFS := -DWAVETABLE_SYNTH_ENVELOPE -DWAVETABLE_SYNTH_MAX_VOICES=4
+
+wavetable_synth_SRC := \
+	$(QUANTUM_PATH)/audio/tests/wavetable_synth_tests.cpp \
+	$(QUANTUM_PATH)/audio/wavetable_synth.c
@@ -0,0 +1,233 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "wavetable_synth.h"
+#include "song_list.h"
+}
+
+#define SAMPLE_RATE 16384U // AUDIO_DAC_QUALITY_SANE_MINIMUM
+#define EFFECTIVE_SAMPLE_RATE (SAMPLE_RATE * 3.0f / 2.0f)
+#define SAMPLE_MAX 4095U
+#define OFF_VALUE (SAMPLE_MAX / 2)
+
+static float ode_to_joy[][2] = SONG(ODE_TO_JOY);
+static float startup[][2]    = SONG(STARTUP_SOUND);
+
+class WavetableSynth : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (size_t i = 0; i < WAVETABLE_SYNTH_TABLE_SIZE; i++) {
+            table[i] = (uint16_t)((1.0 - cos(2 * M_PI * i / WAVETABLE_SYNTH_TABLE_SIZE)) / 2 * SAMPLE_MAX + 0.5);
+        }
+        wavetable_synth_init(&synth, table, OFF_VALUE);
+    }
+
+    size_t note_length(float duration) {
+        // a quarter note (16) is one beat
+        return (size_t)(duration * 60.0f / TEMPO_DEFAULT / 16 * SAMPLE_RATE);
+    }
+
+    // the floating point path of audio_dac_additive.c, with one tone per note
+    std::vector<uint16_t> render_float(float (*song)[2], size_t notes) {
+        std::vector<uint16_t> pcm;
+        float                 dac_if = 0.0f;
+        for (size_t n = 0; n < notes; n++) {
+            float frequency = song[n][0];
+            for (size_t s = 0; s < note_length(song[n][1]); s++) {
+                if (frequency == 0.0f) {
+                    pcm.push_back(OFF_VALUE);
+                    continue;
+                }
+                dac_if = dac_if + ((frequency * WAVETABLE_SYNTH_TABLE_SIZE) / SAMPLE_RATE) * 2 / 3;
+                dac_if = fmod(dac_if, WAVETABLE_SYNTH_TABLE_SIZE);
+                pcm.push_back(table[(uint16_t)dac_if]);
+            }
+        }
+        return pcm;
+    }
+
+    std::vector<uint16_t> render_fixed(float (*song)[2], size_t notes) {
+        std::vector<uint16_t> pcm;
+        for (size_t n = 0; n < notes; n++) {
+            float frequency = song[n][0];
+            wavetable_synth_set_voices(&synth, &frequency, frequency > 0.0f ? 1 : 0, EFFECTIVE_SAMPLE_RATE);
+            size_t offset = pcm.size();
+            pcm.resize(offset + note_length(song[n][1]));
+            wavetable_synth_render(&synth, pcm.data() + offset, pcm.size() - offset);
+        }
+        return pcm;
+    }
+
+    void expect_similar(const std::vector<uint16_t>& reference, const std::vector<uint16_t>& actual) {
+        ASSERT_EQ(reference.size(), actual.size());
+        double sum_squares = 0;
+        int    max_error   = 0;
+        for (size_t i = 0; i < reference.size(); i++) {
+            int error = abs((int)reference[i] - (int)actual[i]);
+            max_error = error > max_error ? error : max_error;
+            sum_squares += (double)error * error;
+        }
+        // the float path truncates the table index, the fixed point path interpolates;
+        // so the two may differ by up to one table step of the steepest slope
+        EXPECT_LE(max_error, 64);
+        EXPECT_LT(sqrt(sum_squares / reference.size()), 32.0);
+    }
+
+    uint16_t          table[WAVETABLE_SYNTH_TABLE_SIZE];
+    wavetable_synth_t synth;
+};
+
+TEST_F(WavetableSynth, SilenceIsOffValue) {
+    uint16_t pcm[16];
+    wavetable_synth_render(&synth, pcm, 16);
+    for (auto sample : pcm) {
+        EXPECT_EQ(sample, OFF_VALUE);
+    }
+}
+
+TEST_F(WavetableSynth, PhaseIncrementIsQ16) {
+    // one table entry per sample
+    EXPECT_EQ(wavetable_synth_increment(EFFECTIVE_SAMPLE_RATE / WAVETABLE_SYNTH_TABLE_SIZE, EFFECTIVE_SAMPLE_RATE), 1UL << 16);
+    EXPECT_EQ(wavetable_synth_increment(0.0f, EFFECTIVE_SAMPLE_RATE), 0UL);
+}
+
+TEST_F(WavetableSynth, OdeToJoyMatchesFloatPath) {
+    size_t notes = sizeof(ode_to_joy) / sizeof(ode_to_joy[0]);
+    expect_similar(render_float(ode_to_joy, notes), render_fixed(ode_to_joy, notes));
+}
+
+TEST_F(WavetableSynth, StartupSoundMatchesFloatPath) {
+    size_t notes = sizeof(startup) / sizeof(startup[0]);
+    expect_similar(render_float(startup, notes), render_fixed(startup, notes));
+}
+
+TEST_F(WavetableSynth, ChordIsAverageOfVoices) {
+    float frequencies[2] = {NOTE_C4, NOTE_E4};
+
+    wavetable_synth_t single[2];
+    for (int v = 0; v < 2; v++) {
+        wavetable_synth_init(&single[v], table, OFF_VALUE);
+        wavetable_synth_set_voices(&single[v], &frequencies[v], 1, EFFECTIVE_SAMPLE_RATE);
+    }
+    wavetable_synth_set_voices(&synth, frequencies, 2, EFFECTIVE_SAMPLE_RATE);
+
+    for (int i = 0; i < 1000; i++) {
+        int expected = (wavetable_synth_next(&single[0]) + wavetable_synth_next(&single[1])) / 2;
+        EXPECT_NEAR(wavetable_synth_next(&synth), expected, 1);
+    }
+}
+
+TEST_F(WavetableSynth, EnvelopeRampsFromSilence) {
+    const wavetable_envelope_t envelope = {.attack = 100, .decay = 100, .sustain = 0x8000, .release = 50};
+    wavetable_synth_set_envelope(&synth, &envelope);
+
+    float frequency = NOTE_A4;
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+
+    // first sample after note on is close to silence
+    EXPECT_NEAR(wavetable_synth_next(&synth), OFF_VALUE, SAMPLE_MAX / 50);
+
+    // attack + decay done, voice is sustaining at half amplitude
+    uint16_t pcm[2048];
+    wavetable_synth_render(&synth, pcm, 2048);
+    EXPECT_EQ(synth.voices[0].stage, WAVETABLE_ENVELOPE_SUSTAIN);
+    uint16_t peak = 0;
+    for (size_t i = 1024; i < 2048; i++) {
+        peak = pcm[i] > peak ? pcm[i] : peak;
+    }
+    EXPECT_NEAR(peak, OFF_VALUE + SAMPLE_MAX / 4, SAMPLE_MAX / 50);
+
+    // release fades back to silence
+    wavetable_synth_release(&synth);
+    wavetable_synth_render(&synth, pcm, 100);
+    EXPECT_EQ(synth.voices[0].stage, WAVETABLE_ENVELOPE_DONE);
+    EXPECT_EQ(wavetable_synth_next(&synth), OFF_VALUE);
+}
+
+TEST_F(WavetableSynth, ReleasedVoicesPlayUntilFadedOut) {
+    const wavetable_envelope_t envelope = {.attack = 0, .decay = 0, .sustain = 0xFFFF, .release = 1000};
+    wavetable_synth_set_envelope(&synth, &envelope);
+
+    float frequency = NOTE_A4;
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+    uint16_t pcm[1000];
+    wavetable_synth_render(&synth, pcm, 100);
+
+    // the voice keeps sounding through most of the release, releasing it again doesn't restart it
+    wavetable_synth_release(&synth);
+    wavetable_synth_render(&synth, pcm, 500);
+    wavetable_synth_release(&synth);
+    wavetable_synth_render(&synth, pcm + 500, 400);
+    EXPECT_TRUE(wavetable_synth_is_playing(&synth));
+    uint16_t peak = 0;
+    for (size_t i = 800; i < 900; i++) {
+        peak = pcm[i] > peak ? pcm[i] : peak;
+    }
+    EXPECT_GT(peak, OFF_VALUE + SAMPLE_MAX / 50);
+
+    wavetable_synth_render(&synth, pcm, 200);
+    EXPECT_FALSE(wavetable_synth_is_playing(&synth));
+    EXPECT_EQ(wavetable_synth_next(&synth), OFF_VALUE);
+
+    // the same note again starts over
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+    EXPECT_TRUE(wavetable_synth_is_playing(&synth));
+    EXPECT_EQ(synth.voices[0].stage, WAVETABLE_ENVELOPE_ATTACK);
+}
+
+TEST_F(WavetableSynth, RetriggerStartsFromCurrentLevel) {
+    const wavetable_envelope_t envelope = {.attack = 100, .decay = 0, .sustain = 0xFFFF, .release = 1000};
+    wavetable_synth_set_envelope(&synth, &envelope);
+
+    float    frequency = NOTE_A4;
+    uint16_t pcm[500];
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+    wavetable_synth_render(&synth, pcm, 200);
+
+    // half way through the release the same note is played again
+    wavetable_synth_release(&synth);
+    wavetable_synth_render(&synth, pcm, 500);
+    uint32_t level = synth.voices[0].level;
+    ASSERT_GT(level, WAVETABLE_SYNTH_UNITY / 4);
+
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+    EXPECT_EQ(synth.voices[0].stage, WAVETABLE_ENVELOPE_ATTACK);
+    wavetable_synth_next(&synth);
+    EXPECT_GE(synth.voices[0].level, level);
+
+    // a voice added after the others starts from silence
+    float chord[2] = {NOTE_A4, NOTE_E5};
+    wavetable_synth_set_voices(&synth, chord, 2, EFFECTIVE_SAMPLE_RATE);
+    wavetable_synth_next(&synth);
+    EXPECT_LE(synth.voices[1].level, WAVETABLE_SYNTH_UNITY / 100 + 1);
+}
+
+TEST_F(WavetableSynth, ReleaseWithoutEnvelopeStopsVoices) {
+    float frequency = NOTE_A4;
+    wavetable_synth_set_voices(&synth, &frequency, 1, EFFECTIVE_SAMPLE_RATE);
+    EXPECT_TRUE(wavetable_synth_is_playing(&synth));
+
+    wavetable_synth_release(&synth);
+    EXPECT_FALSE(wavetable_synth_is_playing(&synth));
+    EXPECT_EQ(wavetable_synth_next(&synth), OFF_VALUE);
+}
@@ -0,0 +1,214 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "wavetable_synth.h"
+#include <string.h>
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+static void wavetable_envelope_enter(wavetable_voice_t *voice, const wavetable_envelope_t *envelope, wavetable_envelope_stage_t stage) {
+    voice->stage = stage;
+    switch (stage) {
+        case WAVETABLE_ENVELOPE_ATTACK:
+            // rises from the current level, so retriggering a sounding voice doesn't click
+            voice->step = envelope->attack ? WAVETABLE_SYNTH_UNITY / envelope->attack : WAVETABLE_SYNTH_UNITY;
+            break;
+        case WAVETABLE_ENVELOPE_DECAY:
+            voice->step = envelope->decay ? (WAVETABLE_SYNTH_UNITY - envelope->sustain) / envelope->decay : WAVETABLE_SYNTH_UNITY;
+            break;
+        case WAVETABLE_ENVELOPE_RELEASE:
+            voice->step = envelope->release ? voice->level / envelope->release + 1 : WAVETABLE_SYNTH_UNITY;
+            break;
+        default:
+            voice->step = 0;
+            break;
+    }
+}
+
+static uint32_t wavetable_envelope_advance(wavetable_voice_t *voice, const wavetable_envelope_t *envelope) {
+    switch (voice->stage) {
+        case WAVETABLE_ENVELOPE_ATTACK:
+            voice->level += voice->step;
+            if (voice->level >= WAVETABLE_SYNTH_UNITY) {
+                voice->level = WAVETABLE_SYNTH_UNITY;
+                wavetable_envelope_enter(voice, envelope, WAVETABLE_ENVELOPE_DECAY);
+            }
+            break;
+        case WAVETABLE_ENVELOPE_DECAY:
+            if (voice->level <= envelope->sustain + voice->step) {
+                voice->level = envelope->sustain;
+                wavetable_envelope_enter(voice, envelope, WAVETABLE_ENVELOPE_SUSTAIN);
+            } else {
+                voice->level -= voice->step;
+            }
+            break;
+        case WAVETABLE_ENVELOPE_RELEASE:
+            if (voice->level <= voice->step) {
+                voice->level = 0;
+                wavetable_envelope_enter(voice, envelope, WAVETABLE_ENVELOPE_DONE);
+            } else {
+                voice->level -= voice->step;
+            }
+            break;
+        default:
+            break;
+    }
+    return voice->level;
+}
+#endif // WAVETABLE_SYNTH_ENVELOPE
+
+/**
+ * Resets all voices and selects the wavetable to play from.
+ *
+ * @param center output value of silence; usually AUDIO_DAC_OFF_VALUE
+ */
+void wavetable_synth_init(wavetable_synth_t *synth, const uint16_t *table, uint16_t center) {
+    memset(synth->voices, 0, sizeof(synth->voices));
+    synth->count  = 0;
+    synth->gain   = 0;
+    synth->table  = table;
+    synth->center = center;
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+    synth->envelope = NULL;
+#endif
+}
+
+/**
+ * Converts a frequency into a Q16.16 per-sample phase increment.
+ * Meant to be called on tone changes only, not per sample.
+ */
+uint32_t wavetable_synth_increment(float frequency, float sample_rate) {
+    return (uint32_t)((frequency * WAVETABLE_SYNTH_TABLE_SIZE * (float)WAVETABLE_SYNTH_UNITY) / sample_rate + 0.5f);
+}
+
+/**
+ * Updates the set of playing voices.
+ *
+ * Phases are kept for voices that continue playing, so the waveform stays continuous.
+ * With envelopes enabled, voices that are new, changed pitch or were released restart their attack,
+ * new voices from silence and the others from the level they were at.
+ */
+void wavetable_synth_set_voices(wavetable_synth_t *synth, const float *frequencies, uint8_t count, float sample_rate) {
+    if (count > WAVETABLE_SYNTH_MAX_VOICES) {
+        count = WAVETABLE_SYNTH_MAX_VOICES;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        wavetable_voice_t *voice     = &synth->voices[i];
+        uint32_t           increment = wavetable_synth_increment(frequencies[i], sample_rate);
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+        if (i >= synth->count) {
+            voice->level = 0;
+        }
+        if (synth->envelope && (i >= synth->count || voice->increment != increment || voice->stage >= WAVETABLE_ENVELOPE_RELEASE)) {
+            wavetable_envelope_enter(voice, synth->envelope, WAVETABLE_ENVELOPE_ATTACK);
+        }
+#endif
+        voice->increment = increment;
+    }
+
+    synth->count = count;
+    synth->gain  = count ? (1UL << WAVETABLE_SYNTH_GAIN_BITS) / count : 0;
+}
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+/**
+ * Sets the envelope applied to voices started afterwards; NULL disables enveloping.
+ */
+void wavetable_synth_set_envelope(wavetable_synth_t *synth, const wavetable_envelope_t *envelope) {
+    synth->envelope = envelope;
+}
+
+/**
+ * Moves all playing voices into their release stage. They keep sounding until the release
+ * is over, after which the synth has no voices left; voices already releasing are left alone.
+ * Without an envelope the voices stop right away.
+ */
+void wavetable_synth_release(wavetable_synth_t *synth) {
+    if (!synth->envelope) {
+        synth->count = 0;
+        synth->gain  = 0;
+        return;
+    }
+    for (uint8_t i = 0; i < synth->count; i++) {
+        if (synth->voices[i].stage < WAVETABLE_ENVELOPE_RELEASE) {
+            wavetable_envelope_enter(&synth->voices[i], synth->envelope, WAVETABLE_ENVELOPE_RELEASE);
+        }
+    }
+}
+#endif
+
+/**
+ * Whether any voice is still sounding, including released voices that are fading out.
+ */
+bool wavetable_synth_is_playing(const wavetable_synth_t *synth) {
+    return synth->count != 0;
+}
+
+/**
+ * Renders the next output sample, the average of all playing voices.
+ */
+uint16_t wavetable_synth_next(wavetable_synth_t *synth) {
+    if (synth->count == 0) {
+        return synth->center;
+    }
+
+    uint32_t sum = 0;
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+    bool sounding = false;
+#endif
+    for (uint8_t i = 0; i < synth->count; i++) {
+        wavetable_voice_t *voice = &synth->voices[i];
+
+        voice->phase   = (voice->phase + voice->increment) & WAVETABLE_SYNTH_PHASE_MASK;
+        uint16_t index = voice->phase >> WAVETABLE_SYNTH_PHASE_BITS;
+        int32_t  a     = synth->table[index];
+        int32_t  b     = synth->table[(index + 1) & (WAVETABLE_SYNTH_TABLE_SIZE - 1)];
+        // interpolate with the upper 12 bits of the fraction, keeping the product within 32 bits
+        int32_t sample = a + (((b - a) * (int32_t)((voice->phase & 0xFFFF) >> 4)) >> 12);
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+        if (synth->envelope) {
+            uint32_t level = wavetable_envelope_advance(voice, synth->envelope);
+            sample         = synth->center + (((sample - synth->center) * (int32_t)(level >> 4)) >> 12);
+            sounding |= voice->stage != WAVETABLE_ENVELOPE_DONE;
+        } else {
+            sounding = true;
+        }
+#endif
+
+        sum += sample;
+    }
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+    // every voice has faded out after its release, drop them
+    if (!sounding) {
+        synth->count = 0;
+        synth->gain  = 0;
+        return synth->center;
+    }
+#endif
+
+    return (sum * synth->gain) >> WAVETABLE_SYNTH_GAIN_BITS;
+}
+
+/**
+ * Renders a block of samples.
+ */
+void wavetable_synth_render(wavetable_synth_t *synth, uint16_t *buffer, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = wavetable_synth_next(synth);
+    }
+}
@@ -0,0 +1,109 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+  Fixed-point wavetable synthesis
+
+  Every voice keeps a Q16.16 phase accumulator into a wavetable of WAVETABLE_SYNTH_TABLE_SIZE
+  samples. The per-sample phase increment is computed once, when the set of voices changes,
+  so rendering a sample only needs integer adds, shifts and multiplies - no floating point and
+  no division, which matters on M0/M4 parts that run this from the DAC DMA interrupt.
+
+  Consecutive wavetable entries are linearly interpolated, and each voice can optionally be
+  shaped by an ADSR envelope (WAVETABLE_SYNTH_ENVELOPE).
+*/
+
+/**
+ * Number of samples in the wavetable; has to be a power of two.
+ */
+#ifndef WAVETABLE_SYNTH_TABLE_SIZE
+#    define WAVETABLE_SYNTH_TABLE_SIZE 256U
+#endif
+
+#if (WAVETABLE_SYNTH_TABLE_SIZE & (WAVETABLE_SYNTH_TABLE_SIZE - 1)) != 0
+#    error "WAVETABLE_SYNTH_TABLE_SIZE has to be a power of two"
+#endif
+
+#ifndef WAVETABLE_SYNTH_MAX_VOICES
+#    ifdef AUDIO_MAX_SIMULTANEOUS_TONES
+#        define WAVETABLE_SYNTH_MAX_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#    else
+#        define WAVETABLE_SYNTH_MAX_VOICES 8
+#    endif
+#endif
+
+#define WAVETABLE_SYNTH_PHASE_BITS 16
+#define WAVETABLE_SYNTH_PHASE_MASK (((uint32_t)WAVETABLE_SYNTH_TABLE_SIZE << WAVETABLE_SYNTH_PHASE_BITS) - 1)
+#define WAVETABLE_SYNTH_UNITY (1UL << 16)
+#define WAVETABLE_SYNTH_GAIN_BITS 12
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+typedef enum {
+    WAVETABLE_ENVELOPE_ATTACK,
+    WAVETABLE_ENVELOPE_DECAY,
+    WAVETABLE_ENVELOPE_SUSTAIN,
+    WAVETABLE_ENVELOPE_RELEASE,
+    WAVETABLE_ENVELOPE_DONE,
+} wavetable_envelope_stage_t;
+
+/**
+ * ADSR envelope; times are given in samples, the sustain level in Q16 (0xFFFF ~ full volume).
+ */
+typedef struct {
+    uint16_t attack;
+    uint16_t decay;
+    uint16_t sustain;
+    uint16_t release;
+} wavetable_envelope_t;
+#endif
+
+typedef struct {
+    uint32_t phase;     // Q16.16 position within the wavetable
+    uint32_t increment; // Q16.16 phase advance per sample
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+    uint32_t                   level; // Q16 envelope level, 0 .. WAVETABLE_SYNTH_UNITY
+    uint32_t                   step;  // Q16 level change per sample in the current stage
+    wavetable_envelope_stage_t stage;
+#endif
+} wavetable_voice_t;
+
+typedef struct {
+    wavetable_voice_t voices[WAVETABLE_SYNTH_MAX_VOICES];
+    uint8_t           count;
+    uint32_t          gain;   // Q12 mixing gain, 1/count
+    const uint16_t *  table;  // WAVETABLE_SYNTH_TABLE_SIZE samples
+    uint16_t          center; // output value of silence, the envelope scales around it
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+    const wavetable_envelope_t *envelope;
+#endif
+} wavetable_synth_t;
+
+void     wavetable_synth_init(wavetable_synth_t *synth, const uint16_t *table, uint16_t center);
+uint32_t wavetable_synth_increment(float frequency, float sample_rate);
+void     wavetable_synth_set_voices(wavetable_synth_t *synth, const float *frequencies, uint8_t count, float sample_rate);
+uint16_t wavetable_synth_next(wavetable_synth_t *synth);
+void     wavetable_synth_render(wavetable_synth_t *synth, uint16_t *buffer, size_t length);
+bool     wavetable_synth_is_playing(const wavetable_synth_t *synth);
+
+#ifdef WAVETABLE_SYNTH_ENVELOPE
+void wavetable_synth_set_envelope(wavetable_synth_t *synth, const wavetable_envelope_t *envelope);
+void wavetable_synth_release(wavetable_synth_t *synth);
+#endif
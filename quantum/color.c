@@ -18,77 +18,123 @@
 #include "led_tables.h"
 #include "progmem.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
-    RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+#ifndef __AVR__
+// clang-format off
+/* Hue segment (high byte) and the position within it (low byte) for every hue,
+ * that is h * 6 / 255 and (h * 2 - segment * 85) * 3.
+ */
+static const uint16_t PROGMEM hue_segments[256] = {
+    0x0000, 0x0006, 0x000C, 0x0012, 0x0018, 0x001E, 0x0024, 0x002A,
+    0x0030, 0x0036, 0x003C, 0x0042, 0x0048, 0x004E, 0x0054, 0x005A,
+    0x0060, 0x0066, 0x006C, 0x0072, 0x0078, 0x007E, 0x0084, 0x008A,
+    0x0090, 0x0096, 0x009C, 0x00A2, 0x00A8, 0x00AE, 0x00B4, 0x00BA,
+    0x00C0, 0x00C6, 0x00CC, 0x00D2, 0x00D8, 0x00DE, 0x00E4, 0x00EA,
+    0x00F0, 0x00F6, 0x00FC, 0x0103, 0x0109, 0x010F, 0x0115, 0x011B,
+    0x0121, 0x0127, 0x012D, 0x0133, 0x0139, 0x013F, 0x0145, 0x014B,
+    0x0151, 0x0157, 0x015D, 0x0163, 0x0169, 0x016F, 0x0175, 0x017B,
+    0x0181, 0x0187, 0x018D, 0x0193, 0x0199, 0x019F, 0x01A5, 0x01AB,
+    0x01B1, 0x01B7, 0x01BD, 0x01C3, 0x01C9, 0x01CF, 0x01D5, 0x01DB,
+    0x01E1, 0x01E7, 0x01ED, 0x01F3, 0x01F9, 0x0200, 0x0206, 0x020C,
+    0x0212, 0x0218, 0x021E, 0x0224, 0x022A, 0x0230, 0x0236, 0x023C,
+    0x0242, 0x0248, 0x024E, 0x0254, 0x025A, 0x0260, 0x0266, 0x026C,
+    0x0272, 0x0278, 0x027E, 0x0284, 0x028A, 0x0290, 0x0296, 0x029C,
+    0x02A2, 0x02A8, 0x02AE, 0x02B4, 0x02BA, 0x02C0, 0x02C6, 0x02CC,
+    0x02D2, 0x02D8, 0x02DE, 0x02E4, 0x02EA, 0x02F0, 0x02F6, 0x02FC,
+    0x0303, 0x0309, 0x030F, 0x0315, 0x031B, 0x0321, 0x0327, 0x032D,
+    0x0333, 0x0339, 0x033F, 0x0345, 0x034B, 0x0351, 0x0357, 0x035D,
+    0x0363, 0x0369, 0x036F, 0x0375, 0x037B, 0x0381, 0x0387, 0x038D,
+    0x0393, 0x0399, 0x039F, 0x03A5, 0x03AB, 0x03B1, 0x03B7, 0x03BD,
+    0x03C3, 0x03C9, 0x03CF, 0x03D5, 0x03DB, 0x03E1, 0x03E7, 0x03ED,
+    0x03F3, 0x03F9, 0x0400, 0x0406, 0x040C, 0x0412, 0x0418, 0x041E,
+    0x0424, 0x042A, 0x0430, 0x0436, 0x043C, 0x0442, 0x0448, 0x044E,
+    0x0454, 0x045A, 0x0460, 0x0466, 0x046C, 0x0472, 0x0478, 0x047E,
+    0x0484, 0x048A, 0x0490, 0x0496, 0x049C, 0x04A2, 0x04A8, 0x04AE,
+    0x04B4, 0x04BA, 0x04C0, 0x04C6, 0x04CC, 0x04D2, 0x04D8, 0x04DE,
+    0x04E4, 0x04EA, 0x04F0, 0x04F6, 0x04FC, 0x0503, 0x0509, 0x050F,
+    0x0515, 0x051B, 0x0521, 0x0527, 0x052D, 0x0533, 0x0539, 0x053F,
+    0x0545, 0x054B, 0x0551, 0x0557, 0x055D, 0x0563, 0x0569, 0x056F,
+    0x0575, 0x057B, 0x0581, 0x0587, 0x058D, 0x0593, 0x0599, 0x059F,
+    0x05A5, 0x05AB, 0x05B1, 0x05B7, 0x05BD, 0x05C3, 0x05C9, 0x05CF,
+    0x05D5, 0x05DB, 0x05E1, 0x05E7, 0x05ED, 0x05F3, 0x05F9, 0x0600,
+};
+// clang-format on
+#endif
+
+/* The value and saturation dependent parts of the conversion, which LEDs
+ * sharing the same saturation and value can reuse.
+ */
+typedef struct {
+    uint16_t s;
+    uint16_t v;
+    uint8_t  p;
+} hsv_sv_t;
 
-    if (hsv.s == 0) {
+static inline hsv_sv_t hsv_sv(uint8_t s, uint8_t v, bool use_cie) {
+    hsv_sv_t sv;
 #ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
+    if (use_cie) {
+        v = pgm_read_byte(&CIE1931_CURVE[v]);
+    }
 #endif
+    sv.s = s;
+    sv.v = v;
+    sv.p = (sv.v * (255 - sv.s)) >> 8;
+    return sv;
+}
+
+static inline RGB hsv_to_rgb_sv(uint8_t h, const hsv_sv_t *sv) {
+    RGB     rgb;
+    uint8_t region, remainder, q, t;
+
+    if (sv->s == 0) {
+        rgb.r = rgb.g = rgb.b = sv->v;
         return rgb;
     }
 
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
-    }
+#ifdef __AVR__
+    // h * 6 / 255 without the division
+    uint16_t h6 = h * 6;
+    region      = (h6 + 1 + (h6 >> 8)) >> 8;
+    remainder   = (h * 2 - region * 85) * 3;
 #else
-    v = hsv.v;
+    uint16_t segment = pgm_read_word(&hue_segments[h]);
+    region           = segment >> 8;
+    remainder        = segment & 0xFF;
 #endif
 
-    region    = h * 6 / 255;
-    remainder = (h * 2 - region * 85) * 3;
-
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    q = (sv->v * (255 - ((sv->s * remainder) >> 8))) >> 8;
+    t = (sv->v * (255 - ((sv->s * (255 - remainder)) >> 8))) >> 8;
 
     switch (region) {
         case 6:
         case 0:
-            rgb.r = v;
+            rgb.r = sv->v;
             rgb.g = t;
-            rgb.b = p;
+            rgb.b = sv->p;
             break;
         case 1:
             rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
+            rgb.g = sv->v;
+            rgb.b = sv->p;
             break;
         case 2:
-            rgb.r = p;
-            rgb.g = v;
+            rgb.r = sv->p;
+            rgb.g = sv->v;
             rgb.b = t;
             break;
         case 3:
-            rgb.r = p;
+            rgb.r = sv->p;
             rgb.g = q;
-            rgb.b = v;
+            rgb.b = sv->v;
             break;
         case 4:
             rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
+            rgb.g = sv->p;
+            rgb.b = sv->v;
             break;
         default:
-            rgb.r = v;
-            rgb.g = p;
+            rgb.r = sv->v;
+            rgb.g = sv->p;
             rgb.b = q;
             break;
     }
@@ -96,6 +142,30 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+    hsv_sv_t sv = hsv_sv(hsv.s, hsv.v, use_cie);
+    return hsv_to_rgb_sv(hsv.h, &sv);
+}
+
+/**
+ * Converts `count` colors at once. The saturation and value math is only
+ * redone when they change from one color to the next.
+ */
+static void hsv_to_rgb_span_impl(const HSV *hsv, RGB *rgb, uint8_t count, bool use_cie) {
+    if (count == 0) {
+        return;
+    }
+
+    hsv_sv_t sv = hsv_sv(hsv[0].s, hsv[0].v, use_cie);
+    rgb[0]      = hsv_to_rgb_sv(hsv[0].h, &sv);
+    for (uint8_t i = 1; i < count; i++) {
+        if (hsv[i].s != hsv[i - 1].s || hsv[i].v != hsv[i - 1].v) {
+            sv = hsv_sv(hsv[i].s, hsv[i].v, use_cie);
+        }
+        rgb[i] = hsv_to_rgb_sv(hsv[i].h, &sv);
+    }
+}
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -108,6 +178,14 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+void hsv_to_rgb_span(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_span_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_span_impl(hsv, rgb, count, false);
+#endif
+}
+
 #ifdef RGBW
 #    ifndef MIN
 #        define MIN(a, b) ((a) < (b) ? (a) : (b))
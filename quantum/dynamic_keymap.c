@@ -117,6 +117,7 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    layer_resolution_cache_clear();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -187,6 +188,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+    layer_resolution_cache_clear();
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -56,6 +56,14 @@ static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1,
 static uint8_t encoder_state[NUM_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUM_ENCODERS] = {0};
 
+#ifdef ENCODER_INTERRUPT
+// Net steps decoded by the interrupt handler, only ever written there. The main loop keeps its own copy and handles the difference, so neither side needs to lock.
+static volatile uint8_t encoder_isr_steps[NUM_ENCODERS_MAX_PER_SIDE]      = {0};
+static uint8_t          encoder_isr_steps_seen[NUM_ENCODERS_MAX_PER_SIDE] = {0};
+// Set for encoders whose pin change interrupts couldn't be set up, encoder_read() then decodes their pads itself
+static bool encoder_isr_polled[NUM_ENCODERS_MAX_PER_SIDE] = {0};
+#endif
+
 // encoder counts
 static uint8_t thisCount;
 #ifdef SPLIT_KEYBOARD
@@ -97,6 +105,11 @@ void encoder_init(void) {
     memset(encoder_value, 0, sizeof(encoder_value));
     memset(encoder_state, 0, sizeof(encoder_state));
     memset(encoder_pulses, 0, sizeof(encoder_pulses));
+#    ifdef ENCODER_INTERRUPT
+    memset((void *)encoder_isr_steps, 0, sizeof(encoder_isr_steps));
+    memset(encoder_isr_steps_seen, 0, sizeof(encoder_isr_steps_seen));
+    memset(encoder_isr_polled, 0, sizeof(encoder_isr_polled));
+#    endif
     static const pin_t encoders_pad_a_left[] = ENCODERS_PAD_A;
     static const pin_t encoders_pad_b_left[] = ENCODERS_PAD_B;
     for (uint8_t i = 0; i < thisCount; i++) {
@@ -137,6 +150,12 @@ void encoder_init(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
+
+#ifdef ENCODER_INTERRUPT
+    for (uint8_t i = 0; i < thisCount; i++) {
+        encoder_interrupt_init(encoders_pad_a[i], encoders_pad_b[i], i);
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -149,9 +168,9 @@ static void encoder_exec_mapping(uint8_t index, bool clockwise) {
 }
 #endif // ENCODER_MAP_ENABLE
 
-static bool encoder_update(uint8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
+/** Accumulates a transition of the encoder pads. Returns 1 for a full step counter clockwise, -1 for clockwise, and 0 otherwise. */
+static int8_t encoder_decode(uint8_t i, uint8_t state) {
+    int8_t step = 0;
 
 #ifdef ENCODER_RESOLUTIONS
     const uint8_t resolution = encoder_resolutions[i];
@@ -159,46 +178,116 @@ static bool encoder_update(uint8_t index, uint8_t state) {
     const uint8_t resolution = ENCODER_RESOLUTION;
 #endif
 
+    encoder_pulses[i] += encoder_LUT[state & 0xF];
+    if (encoder_pulses[i] >= resolution) {
+        step = 1;
+    }
+    if (encoder_pulses[i] <= -resolution) { // direction is arbitrary here, but this clockwise
+        step = -1;
+    }
+    encoder_pulses[i] %= resolution;
+#ifdef ENCODER_DEFAULT_POS
+    if ((state & 0x3) == ENCODER_DEFAULT_POS) {
+        encoder_pulses[i] = 0;
+    }
+#endif
+    return step;
+}
+
+static bool encoder_update(uint8_t index, int8_t step) {
 #ifdef SPLIT_KEYBOARD
     index += thisHand;
 #endif
-    encoder_pulses[i] += encoder_LUT[state & 0xF];
-    if (encoder_pulses[i] >= resolution) {
+    if (step > 0) {
         encoder_value[index]++;
-        changed = true;
 #ifdef ENCODER_MAP_ENABLE
         encoder_exec_mapping(index, ENCODER_COUNTER_CLOCKWISE);
 #else  // ENCODER_MAP_ENABLE
         encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
 #endif // ENCODER_MAP_ENABLE
     }
-    if (encoder_pulses[i] <= -resolution) { // direction is arbitrary here, but this clockwise
+    if (step < 0) {
         encoder_value[index]--;
-        changed = true;
 #ifdef ENCODER_MAP_ENABLE
         encoder_exec_mapping(index, ENCODER_CLOCKWISE);
 #else  // ENCODER_MAP_ENABLE
         encoder_update_kb(index, ENCODER_CLOCKWISE);
 #endif // ENCODER_MAP_ENABLE
     }
-    encoder_pulses[i] %= resolution;
-#ifdef ENCODER_DEFAULT_POS
-    if ((state & 0x3) == ENCODER_DEFAULT_POS) {
-        encoder_pulses[i] = 0;
+    return step != 0;
+}
+
+#ifdef ENCODER_INTERRUPT
+/** Decodes the current state of the pads of encoder `index`. Call from the pin change interrupt of either pad. */
+void encoder_interrupt_read(uint8_t index) {
+    uint8_t new_status = (readPin(encoders_pad_a[index]) << 0) | (readPin(encoders_pad_b[index]) << 1);
+    if ((encoder_state[index] & 0x3) != new_status) {
+        encoder_state[index] <<= 2;
+        encoder_state[index] |= new_status;
+        encoder_isr_steps[index] += encoder_decode(index, encoder_state[index]);
     }
-#endif
-    return changed;
 }
 
+/** Decodes the pads of encoder `index` from encoder_read() instead, for when its pin change interrupts can't be set up. */
+void encoder_interrupt_poll(uint8_t index) {
+    encoder_isr_polled[index] = true;
+}
+
+#    if defined(PROTOCOL_CHIBIOS)
+static void encoder_pal_callback(void *arg) {
+    encoder_interrupt_read((uint8_t)(uintptr_t)arg);
+}
+
+/** Needs PAL_USE_CALLBACKS enabled in halconf.h */
+__attribute__((weak)) void encoder_interrupt_init(pin_t pad_a, pin_t pad_b, uint8_t index) {
+    // Pads with the same number share one interrupt line even on different ports (EXTI on STM32), and setting
+    // a second callback on it would silently replace the first. Encoders that would have to share are polled.
+    static bool line_taken[PAL_IOPORTS_WIDTH] = {0};
+    if (PAL_PAD(pad_a) == PAL_PAD(pad_b) || line_taken[PAL_PAD(pad_a)] || line_taken[PAL_PAD(pad_b)]) {
+        encoder_interrupt_poll(index);
+        return;
+    }
+    line_taken[PAL_PAD(pad_a)] = true;
+    line_taken[PAL_PAD(pad_b)] = true;
+    palSetLineCallback(pad_a, encoder_pal_callback, (void *)(uintptr_t)index);
+    palSetLineCallback(pad_b, encoder_pal_callback, (void *)(uintptr_t)index);
+    palEnableLineEvent(pad_a, PAL_EVENT_MODE_BOTH_EDGES);
+    palEnableLineEvent(pad_b, PAL_EVENT_MODE_BOTH_EDGES);
+}
+#    else
+/** Has to be implemented by the keyboard, setting up pin change interrupts that call encoder_interrupt_read(). Without it the pads are polled. */
+__attribute__((weak)) void encoder_interrupt_init(pin_t pad_a, pin_t pad_b, uint8_t index) {
+    encoder_interrupt_poll(index);
+}
+#    endif
+#endif // ENCODER_INTERRUPT
+
 bool encoder_read(void) {
     bool changed = false;
     for (uint8_t i = 0; i < thisCount; i++) {
+#ifdef ENCODER_INTERRUPT
+        if (encoder_isr_polled[i]) {
+            encoder_interrupt_read(i);
+        }
+        uint8_t steps             = encoder_isr_steps[i];
+        int8_t  delta             = steps - encoder_isr_steps_seen[i];
+        encoder_isr_steps_seen[i] = steps;
+        while (delta > 0) {
+            delta--;
+            changed |= encoder_update(i, 1);
+        }
+        while (delta < 0) {
+            delta++;
+            changed |= encoder_update(i, -1);
+        }
+#else
         uint8_t new_status = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
         if ((encoder_state[i] & 0x3) != new_status) {
             encoder_state[i] <<= 2;
             encoder_state[i] |= new_status;
-            changed |= encoder_update(i, encoder_state[i]);
+            changed |= encoder_update(i, encoder_decode(i, encoder_state[i]));
         }
+#endif
     }
     return changed;
 }
@@ -26,6 +26,12 @@ bool encoder_read(void);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#ifdef ENCODER_INTERRUPT
+void encoder_interrupt_init(pin_t pad_a, pin_t pad_b, uint8_t index);
+void encoder_interrupt_read(uint8_t index);
+void encoder_interrupt_poll(uint8_t index);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 
 void encoder_state_raw(uint8_t* slave_state);
@@ -0,0 +1,148 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t updates_array_idx = 0;
+update  updates[32];
+uint8_t interrupt_inits = 0;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates[updates_array_idx % 32] = {index, clockwise};
+    updates_array_idx++;
+    return true;
+}
+
+void encoder_interrupt_init(pin_t pad_a, pin_t pad_b, uint8_t index) {
+    interrupt_inits++;
+}
+
+// What the pin change interrupt does
+void setAndInterrupt(pin_t pin, bool val) {
+    setPin(pin, val);
+    encoder_interrupt_read(0);
+}
+
+void clockwiseStep(void) {
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, true);
+    setAndInterrupt(1, true);
+}
+
+void counterClockwiseStep(void) {
+    setAndInterrupt(1, false);
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, true);
+    setAndInterrupt(0, true);
+}
+
+class EncoderInterruptTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        updates_array_idx = 0;
+        interrupt_inits   = 0;
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderInterruptTest, TestInit) {
+    EXPECT_EQ(interrupt_inits, 1);
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(updates_array_idx, 0);
+}
+
+TEST_F(EncoderInterruptTest, TestStepsOnlyReportedByRead) {
+    clockwiseStep();
+    EXPECT_EQ(updates_array_idx, 0);
+
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(updates_array_idx, 1);
+}
+
+TEST_F(EncoderInterruptTest, TestFastSpinKeepsEveryStep) {
+    // a slow main loop: many steps arrive before the next read
+    for (int i = 0; i < 20; i++) {
+        counterClockwiseStep();
+    }
+    EXPECT_EQ(updates_array_idx, 0);
+
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(updates_array_idx, 20);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(updates[i].clockwise, false);
+    }
+}
+
+TEST_F(EncoderInterruptTest, TestDirectionChangesBetweenReads) {
+    clockwiseStep();
+    clockwiseStep();
+    clockwiseStep();
+    counterClockwiseStep();
+
+    // only the net movement is reported
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(updates_array_idx, 2);
+    EXPECT_EQ(updates[0].clockwise, true);
+    EXPECT_EQ(updates[1].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestPartialStepCarriesOver) {
+    setAndInterrupt(0, false);
+    setAndInterrupt(1, false);
+    EXPECT_EQ(encoder_read(), false);
+
+    setAndInterrupt(0, true);
+    setAndInterrupt(1, true);
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptTest, TestPolledEncoderReadByMainLoop) {
+    // as if its interrupt line was taken by another encoder
+    encoder_interrupt_poll(0);
+
+    setPin(0, false);
+    encoder_read();
+    setPin(1, false);
+    encoder_read();
+    setPin(0, true);
+    encoder_read();
+    setPin(1, true);
+    EXPECT_EQ(encoder_read(), true);
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
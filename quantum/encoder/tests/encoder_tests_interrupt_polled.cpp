@@ -0,0 +1,82 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+}
+
+// No encoder_interrupt_init() here, so the pads have to be polled
+
+struct update {
+    int8_t index;
+    bool   clockwise;
+};
+
+uint8_t updates_array_idx = 0;
+update  updates[32];
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    updates[updates_array_idx % 32] = {index, clockwise};
+    updates_array_idx++;
+    return true;
+}
+
+bool setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    return encoder_read();
+}
+
+class EncoderInterruptPolledTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        updates_array_idx = 0;
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderInterruptPolledTest, TestInit) {
+    EXPECT_EQ(encoder_read(), false);
+    EXPECT_EQ(updates_array_idx, 0);
+}
+
+TEST_F(EncoderInterruptPolledTest, TestOneClockwise) {
+    setAndRead(0, false);
+    setAndRead(1, false);
+    setAndRead(0, true);
+    EXPECT_EQ(setAndRead(1, true), true);
+
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, true);
+}
+
+TEST_F(EncoderInterruptPolledTest, TestOneCounterClockwise) {
+    setAndRead(1, false);
+    setAndRead(0, false);
+    setAndRead(1, true);
+    EXPECT_EQ(setAndRead(0, true), true);
+
+    EXPECT_EQ(updates_array_idx, 1);
+    EXPECT_EQ(updates[0].index, 0);
+    EXPECT_EQ(updates[0].clockwise, false);
+}
@@ -7,6 +7,24 @@ encoder_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
+encoder_interrupt_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_INTERRUPT
+encoder_interrupt_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_interrupt_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_interrupt.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
+encoder_interrupt_polled_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_INTERRUPT
+encoder_interrupt_polled_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_interrupt_polled_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_interrupt_polled.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
 encoder_split_left_eq_right_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT
 encoder_split_left_eq_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_eq_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
@@ -169,6 +169,167 @@ uint32_t get_matrix_scan_rate(void) {
 #    define matrix_scan_perf_task()
 #endif
 
+// With no lighting or display feature enabled there is nothing to defer
+#if defined(KEYBOARD_TASK_SCHEDULER) && !defined(RGBLIGHT_ENABLE) && !defined(LED_MATRIX_ENABLE) && !defined(RGB_MATRIX_ENABLE) && !(defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))) && !defined(OLED_ENABLE) && !defined(ST7565_ENABLE)
+#    undef KEYBOARD_TASK_SCHEDULER
+#endif
+
+#ifdef KEYBOARD_TASK_SCHEDULER
+// How long after the last matrix change input still counts as in flight, covering debounce
+#    ifndef KEYBOARD_TASK_BUSY_TIME
+#        define KEYBOARD_TASK_BUSY_TIME 20
+#    endif
+// Longest a deferred task is held back while input is in flight, in milliseconds
+#    ifndef KEYBOARD_TASK_DEADLINE
+#        define KEYBOARD_TASK_DEADLINE 50
+#    endif
+
+typedef struct {
+    void (*task)(void);
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+    const char *name;
+#    endif
+} deferred_task_t;
+
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+#        define DEFERRED_TASK(task) \
+            { task, #task }
+#    else
+#        define DEFERRED_TASK(task) \
+            { task }
+#    endif
+
+/* Lighting and display tasks. These can take several milliseconds to
+ * render a frame, so while a key is in flight they only run in the time
+ * left over after scanning, or once their deadline has passed.
+ */
+static const deferred_task_t deferred_tasks[] = {
+#    ifdef RGBLIGHT_ENABLE
+    DEFERRED_TASK(rgblight_task),
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    DEFERRED_TASK(led_matrix_task),
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    DEFERRED_TASK(rgb_matrix_task),
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    DEFERRED_TASK(backlight_task),
+#    endif
+#    ifdef OLED_ENABLE
+    DEFERRED_TASK(oled_task),
+#    endif
+#    ifdef ST7565_ENABLE
+    DEFERRED_TASK(st7565_task),
+#    endif
+};
+
+#    define DEFERRED_TASK_COUNT (sizeof(deferred_tasks) / sizeof(deferred_tasks[0]))
+
+static uint32_t deferred_task_last_run[DEFERRED_TASK_COUNT];
+
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+typedef struct {
+    uint32_t runs;
+    uint32_t deferrals;
+    uint32_t total_time;
+    uint32_t max_time;
+} deferred_task_stats_t;
+
+static deferred_task_stats_t deferred_task_stats[DEFERRED_TASK_COUNT];
+static uint32_t              deferred_task_stats_timer = 0;
+static uint32_t              busy_pass_count           = 0;
+static uint32_t              pass_count                = 0;
+
+/** \brief Prints the runtime statistics of the deferred tasks to the console once a second
+ */
+static void deferred_task_stats_task(bool busy) {
+    pass_count++;
+    if (busy) busy_pass_count++;
+
+    uint32_t timer_now = timer_read32();
+    if (TIMER_DIFF_32(timer_now, deferred_task_stats_timer) < 1000) {
+        return;
+    }
+    dprintf("keyboard task passes: %lu, busy: %lu\n", pass_count, busy_pass_count);
+    for (uint8_t i = 0; i < DEFERRED_TASK_COUNT; i++) {
+        deferred_task_stats_t *stats = &deferred_task_stats[i];
+        dprintf("  %s: runs %lu, deferred %lu, total %lums, max %lums\n", deferred_tasks[i].name, stats->runs, stats->deferrals, stats->total_time, stats->max_time);
+        *stats = (deferred_task_stats_t){0};
+    }
+    deferred_task_stats_timer = timer_now;
+    pass_count                = 0;
+    busy_pass_count           = 0;
+}
+#    endif
+
+static void deferred_task_run(uint8_t index) {
+    uint32_t start = timer_read32();
+    deferred_tasks[index].task();
+    deferred_task_last_run[index] = timer_read32();
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+    uint32_t duration = TIMER_DIFF_32(deferred_task_last_run[index], start);
+    deferred_task_stats[index].runs++;
+    deferred_task_stats[index].total_time += duration;
+    if (duration > deferred_task_stats[index].max_time) {
+        deferred_task_stats[index].max_time = duration;
+    }
+#    else
+    (void)start;
+#    endif
+}
+
+/** \brief Checks whether a key press is still being processed
+ *
+ * That is a recent matrix change, which may still be debouncing, or an unresolved tap-hold key.
+ */
+static bool keyboard_input_in_flight(void) {
+    if (last_matrix_activity_elapsed() < KEYBOARD_TASK_BUSY_TIME) {
+        return true;
+    }
+#    ifndef NO_ACTION_TAPPING
+    if (action_tapping_is_pending()) {
+        return true;
+    }
+#    endif
+    return false;
+}
+
+/** \brief Runs the deferred tasks
+ *
+ * With no input in flight all of them run, as they would without the scheduler.
+ * Otherwise a task only runs once it has not run for KEYBOARD_TASK_DEADLINE,
+ * and at most one task runs per pass, taking turns, so that a pass never
+ * renders more than one frame while a key is in flight.
+ */
+static void deferred_tasks_task(void) {
+    static uint8_t next = 0;
+    bool           busy = keyboard_input_in_flight();
+    bool           ran  = false;
+
+    for (uint8_t i = 0; i < DEFERRED_TASK_COUNT; i++) {
+        uint8_t index = next + i;
+        if (index >= DEFERRED_TASK_COUNT) index -= DEFERRED_TASK_COUNT;
+        if (!busy) {
+            deferred_task_run(index);
+        } else if (!ran && timer_elapsed32(deferred_task_last_run[index]) >= KEYBOARD_TASK_DEADLINE) {
+            deferred_task_run(index);
+            ran  = true;
+            next = index + 1 < DEFERRED_TASK_COUNT ? index + 1 : 0;
+        }
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+        else {
+            deferred_task_stats[index].deferrals++;
+        }
+#    endif
+    }
+
+#    ifdef DEBUG_KEYBOARD_TASK_STATS
+    deferred_task_stats_task(busy);
+#    endif
+}
+#endif
+
 #ifdef MATRIX_HAS_GHOST
 extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
 static matrix_row_t   get_real_keys(uint8_t row, matrix_row_t rowdata) {
@@ -404,7 +565,7 @@ void keyboard_init(void) {
     split_post_init();
 #endif
 
-#if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
+#if (defined(DEBUG_MATRIX_SCAN_RATE) || defined(DEBUG_KEYBOARD_TASK_STATS)) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
 
@@ -524,6 +685,10 @@ void quantum_task(void) {
     key_override_task();
 #endif
 
+#ifdef LEADER_ENABLE
+    leader_task();
+#endif
+
 #ifdef SEQUENCER_ENABLE
     sequencer_task();
 #endif
@@ -578,20 +743,22 @@ void keyboard_task(void) {
 
     quantum_task();
 
-#if defined(RGBLIGHT_ENABLE)
+#ifndef KEYBOARD_TASK_SCHEDULER
+#    if defined(RGBLIGHT_ENABLE)
     rgblight_task();
-#endif
+#    endif
 
-#ifdef LED_MATRIX_ENABLE
+#    ifdef LED_MATRIX_ENABLE
     led_matrix_task();
-#endif
-#ifdef RGB_MATRIX_ENABLE
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
-#endif
+#    endif
 
-#if defined(BACKLIGHT_ENABLE)
-#    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
+#    if defined(BACKLIGHT_ENABLE)
+#        if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
+#        endif
 #    endif
 #endif
 
@@ -601,7 +768,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef OLED_ENABLE
+#    ifndef KEYBOARD_TASK_SCHEDULER
     oled_task();
+#    endif
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -613,7 +782,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
+#    ifndef KEYBOARD_TASK_SCHEDULER
     st7565_task();
+#    endif
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -659,5 +830,9 @@ void keyboard_task(void) {
     programmable_button_send();
 #endif
 
+#ifdef KEYBOARD_TASK_SCHEDULER
+    deferred_tasks_task();
+#endif
+
     led_task();
 }
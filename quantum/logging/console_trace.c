@@ -0,0 +1,173 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "console_trace.h"
+#include "timer.h"
+
+#ifdef PROTOCOL_CHIBIOS
+#    include "usb_descriptor.h"
+#endif
+
+#ifndef CONSOLE_EPSIZE
+#    error "console_trace.c needs CONSOLE_EPSIZE, the size of the packets sent to the host"
+#endif
+
+// Time a partly filled packet may wait for more data, in milliseconds
+#ifndef CONSOLE_TRACE_FLUSH_INTERVAL
+#    define CONSOLE_TRACE_FLUSH_INTERVAL 10
+#endif
+
+#define TRACE_MASK (CONSOLE_TRACE_BUFFER_SIZE - 1)
+#define TRACE_TEXT_MAX 63
+
+// Start of the format strings, defined by the linker
+extern const char __start_qmk_trace[];
+
+/* Both sides run from the main loop, like print() does. The indices run freely and are
+ * masked on access: unsent bytes are [tail, head), [head, write) is the open text record.
+ */
+static uint8_t  trace_buffer[CONSOLE_TRACE_BUFFER_SIZE];
+static uint16_t trace_tail;
+static uint16_t trace_head;
+static uint16_t trace_write;
+static uint16_t trace_dropped;
+static uint32_t trace_last_flush;
+
+// The packet being sent, kept until the host has taken all of it
+static uint8_t trace_packet[CONSOLE_EPSIZE];
+static uint8_t trace_packet_sent = sizeof(trace_packet);
+
+static inline uint16_t trace_free(void) {
+    return CONSOLE_TRACE_BUFFER_SIZE - (uint16_t)(trace_write - trace_tail);
+}
+
+static inline void trace_put(uint8_t byte) {
+    trace_buffer[trace_write++ & TRACE_MASK] = byte;
+}
+
+static inline void trace_put16(uint16_t value) {
+    trace_put(value & 0xFF);
+    trace_put(value >> 8);
+}
+
+static inline bool trace_text_open(void) {
+    return trace_write != trace_head;
+}
+
+// Finishes the open text record, if any, making it available for sending
+static void trace_commit(void) {
+    if (trace_text_open()) {
+        trace_buffer[trace_head & TRACE_MASK] = CONSOLE_TRACE_RECORD_TEXT | (uint8_t)(trace_write - trace_head - 1);
+    }
+    trace_head = trace_write;
+}
+
+// Makes room for a record of `length` bytes, preceded by a note of what was dropped before
+static bool trace_reserve(uint8_t length) {
+    uint16_t needed = length + (trace_dropped ? 3 : 0);
+
+    if (trace_free() < needed) {
+        if (trace_dropped < UINT16_MAX) {
+            trace_dropped++;
+        }
+        return false;
+    }
+    if (trace_dropped) {
+        trace_put(CONSOLE_TRACE_RECORD_DROPPED);
+        trace_put16(trace_dropped);
+        trace_dropped = 0;
+        trace_head    = trace_write;
+    }
+    return true;
+}
+
+/**
+ * Queues a message for the host. Use console_trace() rather than calling this directly.
+ *
+ * @param fmt format string, stored in the `qmk_trace` section
+ */
+void console_trace_log(const char *fmt, const uint32_t *args, uint8_t count) {
+    if (count > CONSOLE_TRACE_MAX_ARGS) {
+        count = CONSOLE_TRACE_MAX_ARGS;
+    }
+
+    trace_commit();
+    if (!trace_reserve(3 + count * sizeof(uint32_t))) {
+        return;
+    }
+
+    trace_put(CONSOLE_TRACE_RECORD_FORMAT | count);
+    trace_put16(fmt - __start_qmk_trace);
+    for (uint8_t i = 0; i < count; i++) {
+        trace_put16(args[i] & 0xFFFF);
+        trace_put16(args[i] >> 16);
+    }
+    trace_head = trace_write;
+}
+
+/**
+ * Adds a character to the open text record, the sendchar() of the console in trace mode.
+ */
+int8_t console_trace_putchar(uint8_t c) {
+    if (trace_text_open() && (uint16_t)(trace_write - trace_head) <= TRACE_TEXT_MAX && trace_free() > 0) {
+        trace_put(c);
+    } else {
+        trace_commit();
+        if (!trace_reserve(2)) {
+            return -1;
+        }
+        trace_put(CONSOLE_TRACE_RECORD_TEXT); // header, filled in by trace_commit()
+        trace_put(c);
+    }
+
+    if (c == '\n') {
+        trace_commit();
+    }
+    return 0;
+}
+
+/**
+ * Sends the buffered records in full packets. A partly filled packet is padded and sent
+ * once it has waited CONSOLE_TRACE_FLUSH_INTERVAL. A packet the host only took part of
+ * is finished first, on this or a later call.
+ */
+void console_trace_task(void) {
+    for (;;) {
+        if (trace_packet_sent == sizeof(trace_packet)) {
+            uint16_t pending = trace_write - trace_tail;
+            if (pending == 0 || (pending < sizeof(trace_packet) && timer_elapsed32(trace_last_flush) < CONSOLE_TRACE_FLUSH_INTERVAL)) {
+                return;
+            }
+
+            trace_commit();
+            uint8_t length = pending < sizeof(trace_packet) ? pending : sizeof(trace_packet);
+            for (uint8_t i = 0; i < length; i++) {
+                trace_packet[i] = trace_buffer[(trace_tail + i) & TRACE_MASK];
+            }
+            memset(trace_packet + length, CONSOLE_TRACE_RECORD_PADDING, sizeof(trace_packet) - length);
+            trace_tail += length;
+            trace_packet_sent = 0;
+        }
+
+        trace_packet_sent += console_trace_send(trace_packet + trace_packet_sent, sizeof(trace_packet) - trace_packet_sent);
+        if (trace_packet_sent < sizeof(trace_packet)) {
+            return;
+        }
+        trace_last_flush = timer_read32();
+    }
+}
@@ -0,0 +1,98 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/*
+  Binary console tracing
+
+  Instead of formatting on the keyboard, every trace site stores its format string in the
+  `qmk_trace` section of the firmware and logs the offset of the string plus its raw arguments
+  into a ring buffer. The buffer is sent in full console packets from console_task(), and
+  `qmk console-trace` formats the messages on the host, looking the strings up in the ELF.
+
+  Everything written through sendchar() goes into the same buffer as plain text, so print()
+  and friends keep working and stay in order with the traced messages.
+
+  Stream format, records are packed back to back and may span packets:
+    0x00                          padding, ends the packet
+    0x01 <count:16>               `count` records were dropped because the buffer was full
+    0x40 | length, <text...>      1..63 bytes of plain text
+    0x80 | n, <id:16> <arg:32>*n  format string `id` with n (0..8) arguments
+  All values are little endian.
+*/
+
+#ifndef CONSOLE_TRACE_BUFFER_SIZE
+#    define CONSOLE_TRACE_BUFFER_SIZE 512
+#endif
+
+#if (CONSOLE_TRACE_BUFFER_SIZE & (CONSOLE_TRACE_BUFFER_SIZE - 1)) != 0
+#    error "CONSOLE_TRACE_BUFFER_SIZE has to be a power of two"
+#endif
+
+#define CONSOLE_TRACE_MAX_ARGS 8
+
+#define CONSOLE_TRACE_RECORD_PADDING 0x00
+#define CONSOLE_TRACE_RECORD_DROPPED 0x01
+#define CONSOLE_TRACE_RECORD_TEXT 0x40
+#define CONSOLE_TRACE_RECORD_FORMAT 0x80
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void   console_trace_log(const char *fmt, const uint32_t *args, uint8_t count);
+int8_t console_trace_putchar(uint8_t c);
+void   console_trace_task(void);
+
+/**
+ * Queues a packet for the host without blocking; provided by the USB protocol.
+ *
+ * @return the number of bytes accepted, the rest is offered again later
+ */
+uint8_t console_trace_send(const uint8_t *data, uint8_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+// clang-format off
+#define CONSOLE_TRACE_ARG(x) (uint32_t)(uintptr_t)(x)
+#define CONSOLE_TRACE_ARGS_0()
+#define CONSOLE_TRACE_ARGS_1(a) CONSOLE_TRACE_ARG(a)
+#define CONSOLE_TRACE_ARGS_2(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_1(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_3(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_2(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_4(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_3(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_5(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_4(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_6(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_5(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_7(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_6(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_8(a, ...) CONSOLE_TRACE_ARG(a), CONSOLE_TRACE_ARGS_7(__VA_ARGS__)
+#define CONSOLE_TRACE_ARGS_PICK(_0, _1, _2, _3, _4, _5, _6, _7, _8, name, ...) name
+#define CONSOLE_TRACE_ARGS(...) \
+    CONSOLE_TRACE_ARGS_PICK(_0, ##__VA_ARGS__, CONSOLE_TRACE_ARGS_8, CONSOLE_TRACE_ARGS_7, CONSOLE_TRACE_ARGS_6, CONSOLE_TRACE_ARGS_5, CONSOLE_TRACE_ARGS_4, CONSOLE_TRACE_ARGS_3, CONSOLE_TRACE_ARGS_2, CONSOLE_TRACE_ARGS_1, CONSOLE_TRACE_ARGS_0)(__VA_ARGS__)
+
+/**
+ * Logs a printf style message without formatting it. `fmt` has to be a string literal,
+ * the arguments are truncated to 32 bits; %s only shows text stored in flash.
+ */
+#define console_trace(fmt, ...)                                                                                          \
+    do {                                                                                                                 \
+        static const char __attribute__((section("qmk_trace"))) console_trace_fmt[] = fmt;                               \
+        const uint32_t console_trace_args[] = {0, CONSOLE_TRACE_ARGS(__VA_ARGS__)};                                      \
+        console_trace_log(console_trace_fmt, console_trace_args + 1, sizeof(console_trace_args) / sizeof(uint32_t) - 1); \
+    } while (0)
+// clang-format on
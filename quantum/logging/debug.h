@@ -63,10 +63,18 @@ extern debug_config_t debug_config;
         do {                              \
             if (debug_enable) println(s); \
         } while (0)
-#    define dprintf(fmt, ...)                              \
-        do {                                               \
-            if (debug_enable) xprintf(fmt, ##__VA_ARGS__); \
-        } while (0)
+#    ifdef CONSOLE_TRACE_ENABLE
+#        include "console_trace.h"
+#        define dprintf(fmt, ...)                                    \
+            do {                                                     \
+                if (debug_enable) console_trace(fmt, ##__VA_ARGS__); \
+            } while (0)
+#    else
+#        define dprintf(fmt, ...)                              \
+            do {                                               \
+                if (debug_enable) xprintf(fmt, ##__VA_ARGS__); \
+            } while (0)
+#    endif
 #    define dmsg(s) dprintf("%s at %d: %s\n", __FILE__, __LINE__, s)
 
 /* Deprecated. DO NOT USE these anymore, use dprintf instead. */
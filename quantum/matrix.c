@@ -46,6 +46,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define SPLIT_MUTABLE_COL const
 #endif
 
+#if defined(MATRIX_IDLE_WAKE) && (defined(DIRECT_PINS) || DIODE_DIRECTION != COL2ROW)
+#    error MATRIX_IDLE_WAKE is only supported by COL2ROW matrices
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -169,6 +173,83 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+#                ifndef readPort
+#                    error MATRIX_READ_COLS_BY_PORT is not supported on this platform
+#                endif
+
+// Columns whose pins are consecutive bits of the same port, in column order
+typedef struct {
+    uint8_t     port;      // index into col_ports
+    uint8_t     first_bit; // bit of the first column within the port
+    uint8_t     first_col;
+    uint8_t     width;
+    port_data_t mask; // one bit per column, starting at bit 0
+} matrix_col_run_t;
+
+static port_t           col_ports[MATRIX_COLS];
+static uint8_t          col_port_count = 0;
+static matrix_col_run_t col_runs[MATRIX_COLS];
+static uint8_t          col_run_count = 0;
+
+static void matrix_init_col_runs(void) {
+    col_port_count = 0;
+    col_run_count  = 0;
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue; // reads as released
+        }
+
+        port_t  port = getPinPort(pin);
+        uint8_t bit  = getPinBit(pin);
+
+        uint8_t port_index = 0;
+        while (port_index < col_port_count && col_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == col_port_count) {
+            col_ports[col_port_count++] = port;
+        }
+
+        if (col_run_count > 0) {
+            matrix_col_run_t *run = &col_runs[col_run_count - 1];
+            if (run->port == port_index && run->first_col + run->width == col && run->first_bit + run->width == bit) {
+                run->mask = (run->mask << 1) | 1;
+                run->width++;
+                continue;
+            }
+        }
+
+        matrix_col_run_t *run = &col_runs[col_run_count++];
+        run->port             = port_index;
+        run->first_bit        = bit;
+        run->first_col        = col;
+        run->width            = 1;
+        run->mask             = 1;
+    }
+}
+
+/** Samples every column port once, then moves each run of columns into place with one shift */
+static matrix_row_t matrix_read_cols(void) {
+    port_data_t  port_values[MATRIX_COLS];
+    matrix_row_t current_row_value = 0;
+
+    for (uint8_t i = 0; i < col_port_count; i++) {
+        port_values[i] = readPort(col_ports[i]);
+    }
+
+    for (uint8_t i = 0; i < col_run_count; i++) {
+        const matrix_col_run_t *run = &col_runs[i];
+        // Pin LO means pressed
+        current_row_value |= (matrix_row_t)(((port_data_t)~port_values[run->port] >> run->first_bit) & run->mask) << run->first_col;
+    }
+
+    return current_row_value;
+}
+#            endif // MATRIX_READ_COLS_BY_PORT
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -178,6 +259,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+    current_row_value = matrix_read_cols();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -186,6 +270,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -195,6 +280,64 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_IDLE_WAKE
+#                ifndef MATRIX_IDLE_TIMEOUT
+#                    define MATRIX_IDLE_TIMEOUT 50
+#                endif
+
+// While idle all rows are selected, so any pressed key pulls its column low
+static bool matrix_idle = false;
+
+__attribute__((weak)) void matrix_idle_enter_kb(void) {}
+__attribute__((weak)) void matrix_idle_exit_kb(void) {}
+
+bool matrix_is_idle(void) {
+    return matrix_idle;
+}
+
+static void matrix_idle_enter(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+    matrix_idle = true;
+    matrix_idle_enter_kb();
+}
+
+/** Leaves idle mode if any column is active. Returns whether the matrix has to be scanned. */
+static bool matrix_idle_wake(void) {
+#                ifdef MATRIX_READ_COLS_BY_PORT
+    bool active = matrix_read_cols() != 0;
+#                else
+    bool active = false;
+    for (uint8_t col = 0; col < MATRIX_COLS && !active; col++) {
+        active = readMatrixPin(col_pins[col]) == 0;
+    }
+#                endif
+    if (!active) {
+        return false;
+    }
+
+    matrix_idle_exit_kb();
+    matrix_idle = false;
+    unselect_rows();
+    matrix_output_unselect_delay(0, true); // wait for all Col signals to go HIGH
+    return true;
+}
+
+static void matrix_idle_update(matrix_row_t current_matrix[]) {
+    if (matrix_idle || last_matrix_activity_elapsed() < MATRIX_IDLE_TIMEOUT) {
+        return;
+    }
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (current_matrix[row]) {
+            return;
+        }
+    }
+    matrix_idle_enter();
+}
+#            endif // MATRIX_IDLE_WAKE
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -299,6 +442,13 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_IDLE_WAKE
+    // the rows were just unselected
+    matrix_idle = false;
+#endif
+#if defined(MATRIX_READ_COLS_BY_PORT) && !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+    matrix_init_col_runs();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -321,10 +471,19 @@ uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
+#    ifdef MATRIX_IDLE_WAKE
+    // Nothing is pressed while idle, unless a column went active
+    if (!matrix_idle || matrix_idle_wake())
+#    endif
+    {
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
     }
+#    ifdef MATRIX_IDLE_WAKE
+    matrix_idle_update(curr_matrix);
+#    endif
 #elif (DIODE_DIRECTION == ROW2COL)
     // Set col, read rows
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
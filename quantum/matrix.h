@@ -62,6 +62,13 @@ void matrix_io_delay(void);
 void matrix_power_up(void);
 void matrix_power_down(void);
 
+#ifdef MATRIX_IDLE_WAKE
+/* idle mode: all rows selected, waiting for a column to go active */
+bool matrix_is_idle(void);
+void matrix_idle_enter_kb(void);
+void matrix_idle_exit_kb(void);
+#endif
+
 /* executes code for Quantum */
 void matrix_init_quantum(void);
 void matrix_scan_quantum(void);
@@ -70,6 +70,99 @@ static report_mouse_t local_mouse_report = {};
 
 extern const pointing_device_driver_t pointing_device_driver;
 
+/**
+ * @brief clamps int16_t to int8_t
+ *
+ * @param[in] int16_t value
+ * @return int8_t clamped value
+ */
+static inline int8_t pointing_device_movement_clamp(int16_t value) {
+    if (value < INT8_MIN) {
+        return INT8_MIN;
+    } else if (value > INT8_MAX) {
+        return INT8_MAX;
+    } else {
+        return value;
+    }
+}
+
+#if defined(POINTING_DEVICE_ASYNC_SAMPLING)
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error POINTING_DEVICE_ASYNC_SAMPLING is only supported on ChibiOS based keyboards.
+#    endif
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_ASYNC_SAMPLING not supported when sharing the pointing device report between sides.
+#    endif
+#    include <ch.h>
+#    include <hal.h>
+#    include "atomic_util.h"
+
+#    include "pointing_device_accumulator.h"
+
+static pointing_device_accumulator_t accumulator = {};
+
+// The sampling thread and the main loop both talk to the sensor, so their bus transactions must not interleave.
+static MUTEX_DECL(pointing_device_driver_mutex);
+#    define POINTING_DEVICE_DRIVER_LOCK() chMtxLock(&pointing_device_driver_mutex)
+#    define POINTING_DEVICE_DRIVER_UNLOCK() chMtxUnlock(&pointing_device_driver_mutex)
+
+/**
+ * @brief Reads the sensor once and adds the result to the motion accumulator
+ *
+ * Runs on the sampling thread, so the driver's get_report must not rely on state owned by the main loop.
+ */
+static void pointing_device_sample(void) {
+    report_mouse_t sample = {};
+    ATOMIC_BLOCK_FORCEON {
+        sample.buttons = accumulator.buttons;
+    }
+
+    POINTING_DEVICE_DRIVER_LOCK();
+    sample = pointing_device_driver.get_report(sample);
+    POINTING_DEVICE_DRIVER_UNLOCK();
+
+    ATOMIC_BLOCK_FORCEON {
+        pointing_device_accumulator_add(&accumulator, sample);
+    }
+}
+
+// Samples the sensor at a fixed rate, independent of how long the rest of keyboard_task() takes.
+// When a motion pin is available the thread sleeps until the sensor signals new motion.
+static THD_WORKING_AREA(waPointingDeviceThread, POINTING_DEVICE_ASYNC_STACK_SIZE);
+static THD_FUNCTION(PointingDeviceThread, arg) {
+    (void)arg;
+    chRegSetThreadName("pointing_device");
+    systime_t next = chVTGetSystemTime();
+    while (true) {
+#    ifdef POINTING_DEVICE_MOTION_PIN
+        // Checking the pin and arming the wait under one lock, so an edge in between cannot be missed
+        osalSysLock();
+        if (palReadLine(POINTING_DEVICE_MOTION_PIN)) {
+            palWaitLineTimeoutS(POINTING_DEVICE_MOTION_PIN, TIME_INFINITE);
+            next = chVTGetSystemTimeX();
+        }
+        osalSysUnlock();
+#    endif
+        pointing_device_sample();
+        next = chThdSleepUntilWindowed(next, chTimeAddX(next, TIME_US2I(POINTING_DEVICE_ASYNC_INTERVAL_US)));
+    }
+}
+
+/**
+ * @brief Starts the pointing device sampling thread
+ *
+ */
+static void pointing_device_async_init(void) {
+#    ifdef POINTING_DEVICE_MOTION_PIN
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+#    endif
+    chThdCreateStatic(waPointingDeviceThread, sizeof(waPointingDeviceThread), HIGHPRIO, PointingDeviceThread, NULL);
+}
+#else
+#    define POINTING_DEVICE_DRIVER_LOCK()
+#    define POINTING_DEVICE_DRIVER_UNLOCK()
+#endif // defined(POINTING_DEVICE_ASYNC_SAMPLING)
+
 /**
  * @brief Keyboard level code pointing device initialisation
  *
@@ -139,6 +232,9 @@ __attribute__((weak)) void pointing_device_init(void) {
     pointing_device_driver.init();
 #ifdef POINTING_DEVICE_MOTION_PIN
     setPinInputHigh(POINTING_DEVICE_MOTION_PIN);
+#endif
+#ifdef POINTING_DEVICE_ASYNC_SAMPLING
+    pointing_device_async_init();
 #endif
     pointing_device_init_kb();
     pointing_device_init_user();
@@ -225,27 +321,33 @@ __attribute__((weak)) void pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
+#if defined(POINTING_DEVICE_ASYNC_SAMPLING)
+    ATOMIC_BLOCK_FORCEON {
+        local_mouse_report = pointing_device_accumulator_drain(&accumulator, local_mouse_report);
+    }
+#else
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        if defined(SPLIT_POINTING_ENABLE)
+#            error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#        endif
     if (!readPin(POINTING_DEVICE_MOTION_PIN))
-#endif
+#    endif
 
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
     local_mouse_report.buttons = old_buttons;
     local_mouse_report         = pointing_device_driver.get_report(local_mouse_report);
     old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver.get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
     local_mouse_report = pointing_device_driver.get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
+#    endif // defined(SPLIT_POINTING_ENABLE)
+#endif     // defined(POINTING_DEVICE_ASYNC_SAMPLING)
 
     // allow kb to intercept and modify report
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
@@ -298,7 +400,10 @@ uint16_t pointing_device_get_cpi(void) {
 #if defined(SPLIT_POINTING_ENABLE)
     return POINTING_DEVICE_THIS_SIDE ? pointing_device_driver.get_cpi() : shared_cpi;
 #else
-    return pointing_device_driver.get_cpi();
+    POINTING_DEVICE_DRIVER_LOCK();
+    uint16_t cpi = pointing_device_driver.get_cpi();
+    POINTING_DEVICE_DRIVER_UNLOCK();
+    return cpi;
 #endif
 }
 
@@ -317,7 +422,9 @@ void pointing_device_set_cpi(uint16_t cpi) {
         shared_cpi = cpi;
     }
 #else
+    POINTING_DEVICE_DRIVER_LOCK();
     pointing_device_driver.set_cpi(cpi);
+    POINTING_DEVICE_DRIVER_UNLOCK();
 #endif
 }
 
@@ -341,22 +448,6 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
     }
 }
 
-/**
- * @brief clamps int16_t to int8_t
- *
- * @param[in] int16_t value
- * @return int8_t clamped value
- */
-static inline int8_t pointing_device_movement_clamp(int16_t value) {
-    if (value < INT8_MIN) {
-        return INT8_MIN;
-    } else if (value > INT8_MAX) {
-        return INT8_MAX;
-    } else {
-        return value;
-    }
-}
-
 /**
  * @brief combines 2 mouse reports and returns 2
  *
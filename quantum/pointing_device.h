@@ -90,6 +90,16 @@ report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
 uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 
+#if defined(POINTING_DEVICE_ASYNC_SAMPLING)
+#    if !defined(POINTING_DEVICE_ASYNC_INTERVAL_US)
+#        define POINTING_DEVICE_ASYNC_INTERVAL_US 1000
+#    endif
+// The sampling thread runs the driver's bus transactions and any debug printing, so it needs more than a bare minimum stack.
+#    if !defined(POINTING_DEVICE_ASYNC_STACK_SIZE)
+#        define POINTING_DEVICE_ASYNC_STACK_SIZE 1024
+#    endif
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
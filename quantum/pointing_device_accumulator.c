@@ -0,0 +1,95 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pointing_device_accumulator.h"
+
+/**
+ * @brief adds a movement delta to an accumulator axis, saturating at int16_t
+ *
+ * @param[in] total current accumulated value
+ * @param[in] delta movement to add
+ * @return int16_t saturated sum
+ */
+static inline int16_t pointing_device_accumulate_axis(int16_t total, int8_t delta) {
+    int32_t sum = (int32_t)total + delta;
+    if (sum < INT16_MIN) {
+        return INT16_MIN;
+    } else if (sum > INT16_MAX) {
+        return INT16_MAX;
+    }
+    return sum;
+}
+
+/**
+ * @brief clamps an accumulator axis to what fits into a single report
+ *
+ * @param[in] value accumulated value
+ * @return int8_t clamped value
+ */
+static inline int8_t pointing_device_accumulator_clamp(int16_t value) {
+    if (value < INT8_MIN) {
+        return INT8_MIN;
+    } else if (value > INT8_MAX) {
+        return INT8_MAX;
+    }
+    return value;
+}
+
+/**
+ * @brief Adds a sensor reading to the accumulator
+ *
+ * Movement is summed, buttons are replaced by the latest reading.
+ *
+ * NOTE : Not reentrant, callers sharing the accumulator between threads must lock around it
+ *
+ * @param[in] accumulator pointing_device_accumulator_t to update
+ * @param[in] sample report_mouse_t returned by the driver
+ */
+void pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample) {
+    accumulator->x       = pointing_device_accumulate_axis(accumulator->x, sample.x);
+    accumulator->y       = pointing_device_accumulate_axis(accumulator->y, sample.y);
+    accumulator->h       = pointing_device_accumulate_axis(accumulator->h, sample.h);
+    accumulator->v       = pointing_device_accumulate_axis(accumulator->v, sample.v);
+    accumulator->buttons = sample.buttons;
+}
+
+/**
+ * @brief Moves accumulated motion into a mouse report
+ *
+ * Movement that does not fit into a single report stays in the accumulator and is sent with the next report, so no motion is lost when the report rate is lower than the sensor rate.
+ *
+ * Buttons set by other code, e.g. pointing_device_set_report() or the pointing device keycodes, are kept; only the buttons the sensor reports are updated.
+ *
+ * NOTE : Not reentrant, callers sharing the accumulator between threads must lock around it
+ *
+ * @param[in] accumulator pointing_device_accumulator_t to drain
+ * @param[in] mouse_report report_mouse_t to fill
+ * @return report_mouse_t with accumulated movement and latest buttons
+ */
+report_mouse_t pointing_device_accumulator_drain(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report) {
+    mouse_report.x = pointing_device_accumulator_clamp(accumulator->x);
+    mouse_report.y = pointing_device_accumulator_clamp(accumulator->y);
+    mouse_report.h = pointing_device_accumulator_clamp(accumulator->h);
+    mouse_report.v = pointing_device_accumulator_clamp(accumulator->v);
+    accumulator->x -= mouse_report.x;
+    accumulator->y -= mouse_report.y;
+    accumulator->h -= mouse_report.h;
+    accumulator->v -= mouse_report.v;
+
+    mouse_report.buttons         = (mouse_report.buttons & ~accumulator->drained_buttons) | accumulator->buttons;
+    accumulator->drained_buttons = accumulator->buttons;
+    return mouse_report;
+}
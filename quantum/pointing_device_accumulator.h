@@ -0,0 +1,33 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "report.h"
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t h;
+    int16_t v;
+    uint8_t buttons;
+    // Buttons the sensor reported in the last drained report, so that only those are released when it lets go of them.
+    uint8_t drained_buttons;
+} pointing_device_accumulator_t;
+
+void           pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample);
+report_mouse_t pointing_device_accumulator_drain(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report);
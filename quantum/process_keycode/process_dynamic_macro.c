@@ -17,6 +17,11 @@
 
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
+#include <string.h>
+#ifdef DYNAMIC_MACRO_EEPROM
+#    include "eeprom.h"
+#    include "eeconfig.h"
+#endif
 
 // default feedback method
 void dynamic_macro_led_blink(void) {
@@ -45,37 +50,236 @@ __attribute__((weak)) void dynamic_macro_record_end_user(int8_t direction) {
     dynamic_macro_led_blink();
 }
 
+/* Both macros share one buffer but are written from different ends
+ * of it: macro 1 left-to-right from the beginning, macro 2
+ * right-to-left from the end. The functions below address a macro by
+ * its direction and by offsets from its beginning.
+ *
+ *  macro_buffer      macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^                                 ^
+ *                    macro_length[1]              macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Each key event is stored as a varint (7 bits per byte, least
+ * significant first, the top bit set on all but the last byte) of
+ *
+ *   position << 3 | keycode follows << 2 | tap follows << 1 | pressed
+ *
+ * where the position is row * MATRIX_COLS + col for keys in the
+ * matrix, and MATRIX_ROWS * MATRIX_COLS + (row << 8 | col) for the
+ * special key locations such as encoders and combos. It is followed by
+ * the tap state byte if that isn't zero, and by the combo keycode as
+ * another varint. Event times are not stored, playback happens all at
+ * once. A key event of a matrix with up to 2048 keys takes two bytes
+ * or less, instead of sizeof(keyrecord_t).
+ */
+#define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 9
+
+#define DYNAMIC_MACRO_PRESSED 0x01
+#define DYNAMIC_MACRO_TAP 0x02
+#define DYNAMIC_MACRO_KEYCODE 0x04
+#define DYNAMIC_MACRO_FLAG_BITS 3
+
+_Static_assert(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_SIZE is too large");
+
+static uint8_t  macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+static uint16_t macro_length[2] = {0, 0};
+
+#ifdef DYNAMIC_MACRO_EEPROM
+#    ifndef TOTAL_EEPROM_BYTE_COUNT
+#        error Unknown total EEPROM size. Cannot check that the dynamic macros fit.
+#    endif
+#    ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#        if defined(VIA_ENABLE)
+#            error DYNAMIC_MACRO_EEPROM_ADDR has to be defined so it does not overlap the VIA data
+#        elif defined(PROTOCOL_ARM_ATSAM) && defined(RGB_MATRIX_ENABLE)
+#            error DYNAMIC_MACRO_EEPROM_ADDR has to be defined so it does not overlap the Massdrop LED settings
+#        else
+#            define DYNAMIC_MACRO_EEPROM_ADDR (EECONFIG_SIZE)
+#        endif
+#    endif
+
+// Changes whenever the buffer size changes, so a differently sized buffer is not loaded
+#    define DYNAMIC_MACRO_EEPROM_MAGIC (0xD700 ^ (uint16_t)DYNAMIC_MACRO_BUFFER_SIZE)
+#    define DYNAMIC_MACRO_EEPROM_MAGIC_ADDR ((uint16_t *)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DYNAMIC_MACRO_EEPROM_LENGTH_ADDR ((uint16_t *)(DYNAMIC_MACRO_EEPROM_ADDR + 2))
+#    define DYNAMIC_MACRO_EEPROM_BUFFER_ADDR ((uint8_t *)(DYNAMIC_MACRO_EEPROM_ADDR + 6))
+
+_Static_assert(DYNAMIC_MACRO_EEPROM_ADDR + 6 + DYNAMIC_MACRO_BUFFER_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "The dynamic macros do not fit in the EEPROM, lower DYNAMIC_MACRO_SIZE or configure a larger EEPROM");
+
+static bool macro_loaded = false;
+
+static void dynamic_macro_eeprom_load(void) {
+    macro_loaded = true;
+    if (eeprom_read_word(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR) != DYNAMIC_MACRO_EEPROM_MAGIC) {
+        return;
+    }
+    uint16_t length[2] = {eeprom_read_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR), eeprom_read_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR + 1)};
+    if (length[0] + length[1] > DYNAMIC_MACRO_BUFFER_SIZE) {
+        return;
+    }
+    eeprom_read_block(macro_buffer, DYNAMIC_MACRO_EEPROM_BUFFER_ADDR, DYNAMIC_MACRO_BUFFER_SIZE);
+    macro_length[0] = length[0];
+    macro_length[1] = length[1];
+    dprintf("dynamic macro: loaded, lengths: %u %u\n", length[0], length[1]);
+}
+
+/* Only writes the macro that was just recorded, the other one is unchanged. Both
+ * lengths are written though, as the other one may not have been saved yet.
+ */
+static void dynamic_macro_eeprom_save(int8_t direction) {
+    uint8_t  slot   = direction > 0 ? 0 : 1;
+    uint16_t offset = direction > 0 ? 0 : DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1];
+
+    eeprom_update_block(macro_buffer + offset, DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + offset, macro_length[slot]);
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR, macro_length[0]);
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR + 1, macro_length[1]);
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR, DYNAMIC_MACRO_EEPROM_MAGIC);
+}
+
+void dynamic_macro_reload(void) {
+    macro_length[0] = 0;
+    macro_length[1] = 0;
+    macro_loaded    = false;
+}
+#endif
+
 /* Convenience macros used for retrieving the debug info. All of them
  * need a `direction` variable accessible at the call site.
  */
 #define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+#define DYNAMIC_MACRO_OTHER_LENGTH() (macro_length[direction > 0 ? 1 : 0])
+
+/**
+ * Returns the byte `offset` bytes from the beginning of the macro.
+ */
+static uint8_t *dynamic_macro_byte(int8_t direction, uint16_t offset) {
+    return direction > 0 ? &macro_buffer[offset] : &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset];
+}
+
+static uint8_t dynamic_macro_put_varint(uint8_t *out, uint32_t value) {
+    uint8_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    out[size++] = value;
+    return size;
+}
+
+static uint32_t dynamic_macro_get_varint(int8_t direction, uint16_t *offset) {
+    uint32_t value = 0;
+    uint8_t  shift = 0;
+    uint8_t  byte;
+    do {
+        byte = *dynamic_macro_byte(direction, (*offset)++);
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+/**
+ * Encodes a key event, returns the number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *out, keyrecord_t *record) {
+    keypos_t key      = record->event.key;
+    uint32_t position = (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) ? key.row * MATRIX_COLS + key.col : MATRIX_ROWS * MATRIX_COLS + ((uint16_t)key.row << 8 | key.col);
+    uint8_t  flags    = record->event.pressed ? DYNAMIC_MACRO_PRESSED : 0;
+    uint8_t  tap      = 0;
+    uint16_t keycode  = KC_NO;
+
+#ifndef NO_ACTION_TAPPING
+    memcpy(&tap, &record->tap, sizeof(tap));
+#endif
+#ifdef COMBO_ENABLE
+    keycode = record->keycode;
+#endif
+    if (tap) {
+        flags |= DYNAMIC_MACRO_TAP;
+    }
+    if (keycode != KC_NO) {
+        flags |= DYNAMIC_MACRO_KEYCODE;
+    }
+
+    uint8_t size = dynamic_macro_put_varint(out, position << DYNAMIC_MACRO_FLAG_BITS | flags);
+    if (flags & DYNAMIC_MACRO_TAP) {
+        out[size++] = tap;
+    }
+    if (flags & DYNAMIC_MACRO_KEYCODE) {
+        size += dynamic_macro_put_varint(out + size, keycode);
+    }
+    return size;
+}
+
+/**
+ * Decodes the key event at `offset` and moves `offset` past it.
+ */
+static keyrecord_t dynamic_macro_decode(int8_t direction, uint16_t *offset) {
+    keyrecord_t record   = {0};
+    uint32_t    value    = dynamic_macro_get_varint(direction, offset);
+    uint32_t    position = value >> DYNAMIC_MACRO_FLAG_BITS;
+
+    if (position < MATRIX_ROWS * MATRIX_COLS) {
+        record.event.key = (keypos_t){.row = position / MATRIX_COLS, .col = position % MATRIX_COLS};
+    } else {
+        position -= MATRIX_ROWS * MATRIX_COLS;
+        record.event.key = (keypos_t){.row = position >> 8, .col = position & 0xFF};
+    }
+    record.event.pressed = value & DYNAMIC_MACRO_PRESSED;
+    record.event.time    = timer_read() | 1;
+
+    if (value & DYNAMIC_MACRO_TAP) {
+        uint8_t tap = *dynamic_macro_byte(direction, (*offset)++);
+#ifndef NO_ACTION_TAPPING
+        memcpy(&record.tap, &tap, sizeof(tap));
+#else
+        (void)tap;
+#endif
+    }
+    if (value & DYNAMIC_MACRO_KEYCODE) {
+        uint16_t keycode = dynamic_macro_get_varint(direction, offset);
+#ifdef COMBO_ENABLE
+        record.keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+    return record;
+}
 
 /**
  * Start recording of the dynamic macro.
  *
  * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer) {
+static void dynamic_macro_record_start(uint16_t *macro_pointer) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_user();
 
     clear_keyboard();
     layer_clear();
-    *macro_pointer = macro_buffer;
+    *macro_pointer = 0;
 }
 
 /**
  * Play the dynamic macro.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in] Either +1 or -1, which macro to play.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+static void dynamic_macro_play(int8_t direction) {
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
     layer_state_t saved_layer_state = layer_state;
@@ -83,9 +287,11 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
     clear_keyboard();
     layer_clear();
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+    uint16_t length = macro_length[direction > 0 ? 0 : 1];
+    uint16_t offset = 0;
+    while (offset < length) {
+        keyrecord_t record = dynamic_macro_decode(direction, &offset);
+        process_record(&record);
     }
 
     clear_keyboard();
@@ -98,50 +304,61 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
  * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in]  Either +1 or -1, which macro is being recorded.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(uint16_t *macro_pointer, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && *macro_pointer == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    uint8_t event[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t size = dynamic_macro_encode(event, record);
+
+    /* Stop short of the end of the other macro. */
+    if (*macro_pointer + size + DYNAMIC_MACRO_OTHER_LENGTH() <= DYNAMIC_MACRO_BUFFER_SIZE) {
+        for (uint8_t i = 0; i < size; i++) {
+            *dynamic_macro_byte(direction, (*macro_pointer)++) = event[i];
+        }
     } else {
         dynamic_macro_record_key_user(direction, record);
     }
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), *macro_pointer, (int)(DYNAMIC_MACRO_BUFFER_SIZE - DYNAMIC_MACRO_OTHER_LENGTH()));
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+static void dynamic_macro_record_end(uint16_t macro_pointer, int8_t direction) {
     dynamic_macro_record_end_user(direction);
 
     /* Do not save the keys being held when stopping the recording,
-     * i.e. the keys used to access the layer DYN_REC_STOP is on.
+     * i.e. the keys used to access the layer DYN_REC_STOP is on. The
+     * events can only be decoded front to back, so the macro ends
+     * after the last key-up event.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t offset = 0;
+    uint16_t length = 0;
+    while (offset < macro_pointer) {
+        if (!dynamic_macro_decode(direction, &offset).event.pressed) {
+            length = offset;
+        }
+    }
+    if (length != macro_pointer) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), length);
 
-    *macro_end = macro_pointer;
+    macro_length[direction > 0 ? 0 : 1] = length;
+#ifdef DYNAMIC_MACRO_EEPROM
+    dynamic_macro_eeprom_save(direction);
+#endif
 }
 
 /* Handle the key events related to the dynamic macros. Should be
@@ -155,69 +372,38 @@ void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_poin
  *   }
  */
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
-    /* Both macros use the same buffer but read/write on different
-     * ends of it.
-     *
-     * Macro1 is written left-to-right starting from the beginning of
-     * the buffer.
-     *
-     * Macro2 is written right-to-left starting from the end of the
-     * buffer.
-     *
-     * &macro_buffer   macro_end
-     *  v                   v
-     * +------------------------------------------------------------+
-     * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
-     * +------------------------------------------------------------+
-     *                           ^                                 ^
-     *                         r_macro_end                  r_macro_buffer
-     *
-     * During the recording when one macro encounters the end of the
-     * other macro, the recording is stopped. Apart from this, there
-     * are no arbitrary limits for the macros' length in relation to
-     * each other: for example one can either have two medium sized
-     * macros or one long macro and one short macro. Or even one empty
-     * and one using the whole buffer.
-     */
-    static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-    /* Pointer to the first buffer element after the first macro.
-     * Initially points to the very beginning of the buffer since the
-     * macro is empty. */
-    static keyrecord_t *macro_end = macro_buffer;
-
-    /* The other end of the macro buffer. Serves as the beginning of
-     * the second macro. */
-    static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-    /* Like macro_end but for the second macro. */
-    static keyrecord_t *r_macro_end = r_macro_buffer;
-
     /* A persistent pointer to the current macro position (iterator)
-     * used during the recording. */
-    static keyrecord_t *macro_pointer = NULL;
+     * used during the recording, as an offset from the beginning of
+     * the macro. */
+    static uint16_t macro_pointer = 0;
 
     /* 0   - no macro is being recorded right now
      * 1,2 - either macro 1 or 2 is being recorded */
     static uint8_t macro_id = 0;
 
+#ifdef DYNAMIC_MACRO_EEPROM
+    if (!macro_loaded) {
+        dynamic_macro_eeprom_load();
+    }
+#endif
+
     if (macro_id == 0) {
         /* No macro recording in progress. */
         if (!record->event.pressed) {
             switch (keycode) {
                 case DYN_REC_START1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer);
+                    dynamic_macro_record_start(&macro_pointer);
                     macro_id = 1;
                     return false;
                 case DYN_REC_START2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer);
+                    dynamic_macro_record_start(&macro_pointer);
                     macro_id = 2;
                     return false;
                 case DYN_MACRO_PLAY1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(+1);
                     return false;
                 case DYN_MACRO_PLAY2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(-1);
                     return false;
             }
         }
@@ -233,10 +419,10 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
                                                                           * starts for DYN_REC_STOP. */
                     switch (macro_id) {
                         case 1:
-                            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
+                            dynamic_macro_record_end(macro_pointer, +1);
                             break;
                         case 2:
-                            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
+                            dynamic_macro_record_end(macro_pointer, -1);
                             break;
                     }
                     macro_id = 0;
@@ -252,10 +438,10 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
                 /* Store the key in the macro buffer and process it normally. */
                 switch (macro_id) {
                     case 1:
-                        dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
+                        dynamic_macro_record_key(&macro_pointer, +1, record);
                         break;
                     case 2:
-                        dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
+                        dynamic_macro_record_key(&macro_pointer, -1, record);
                         break;
                 }
                 return true;
@@ -20,10 +20,13 @@
 
 #include "quantum.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. The macros take up
+ * DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t) bytes of RAM, the space
+ * DYNAMIC_MACRO_SIZE uncompressed key events would take. As key events
+ * are stored compactly, usually in two bytes or less, the buffer holds
+ * about four times as many. Be aware that each keypress is recorded
+ * twice because of the down-event and up-event. This is not a bug,
+ * it's the intended behavior.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -39,3 +42,10 @@ void dynamic_macro_record_start_user(void);
 void dynamic_macro_play_user(int8_t direction);
 void dynamic_macro_record_key_user(int8_t direction, keyrecord_t *record);
 void dynamic_macro_record_end_user(int8_t direction);
+
+#ifdef DYNAMIC_MACRO_EEPROM
+/* Forgets the macros in RAM, they are loaded from EEPROM again on the
+ * next key press. Must not be called while a macro is being recorded.
+ */
+void dynamic_macro_reload(void);
+#endif
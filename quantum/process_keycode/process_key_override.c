@@ -243,138 +243,251 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Checks whether the override may activate for this event. Does everything but registering the override. */
+static bool override_can_activate(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
+
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required (KC_NO means 'no key', so only the required modifiers need to be down), yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    if (override->trigger != KC_NO && !(is_trigger && key_down) && last_key_down != override->trigger) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    return true;
+}
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+/** Activates the override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod) {
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    key_override_printf("Activating override\n");
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    clear_active_override(false);
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_KEY(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
         }
+    }
 
-        key_override_printf("Activating override\n");
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-        clear_active_override(false);
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_KEY(override->trigger)) {
-                del_key(override->trigger);
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_KEY(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
+
+#ifdef KEY_OVERRIDE_INDEX_SIZE
+#    if KEY_OVERRIDE_INDEX_SIZE > 255
+#        error "KEY_OVERRIDE_INDEX_SIZE can be at most 255"
+#    endif
+
+// Positions within key_overrides, sorted by trigger keycode and then by position. The KC_NO triggered overrides end up in front.
+static uint8_t                key_override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint8_t                key_override_index_count = 0;
+static bool                   key_override_index_valid = false;
+static const key_override_t **key_override_index_source = NULL;
+
+/** (Re)builds the index if key_overrides changed. Returns false if the overrides don't fit, so the caller falls back to scanning them all */
+static bool key_override_index_update(void) {
+    if (key_override_index_source == key_overrides) {
+        return key_override_index_valid;
+    }
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    key_override_index_source = key_overrides;
+    key_override_index_valid  = false;
+    key_override_index_count  = 0;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        if (key_override_index_count == KEY_OVERRIDE_INDEX_SIZE) {
+            key_override_printf("Too many key overrides to index\n");
+            return false;
         }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+        // Insertion sort, stable so that overrides with the same trigger keep their priority
+        const uint16_t trigger = key_overrides[i]->trigger;
+        uint8_t        j       = key_override_index_count++;
+        while (j > 0 && key_overrides[key_override_index[j - 1]]->trigger > trigger) {
+            key_override_index[j] = key_override_index[j - 1];
+            j--;
+        }
+        key_override_index[j] = i;
+    }
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_KEY(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
-            }
+    key_override_index_valid = true;
+    return true;
+}
+
+/** Returns the first entry of the index whose trigger is not less than `trigger` */
+static uint8_t key_override_index_lower_bound(const uint16_t trigger) {
+    uint8_t first = 0;
+    uint8_t count = key_override_index_count;
+
+    while (count > 0) {
+        const uint8_t step = count / 2;
+        if (key_overrides[key_override_index[first + step]]->trigger < trigger) {
+            first += step + 1;
+            count -= step + 1;
         } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+            count = step;
         }
+    }
+    return first;
+}
 
-        *activated = true;
+/** Like the linear scan, but only visits the overrides that can activate: those triggered by KC_NO, the keycode of the event, or the last key that went down. They are visited in their original order */
+static bool try_activating_indexed_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    const uint16_t triggers[] = {KC_NO, keycode, last_key_down};
+    uint8_t        next[3];
+    uint8_t        end[3];
+
+    for (uint8_t t = 0; t < 3; t++) {
+        next[t] = end[t] = 0;
+        if ((t > 0 && triggers[t] == KC_NO) || (t > 1 && triggers[t] == triggers[1])) {
+            continue;
+        }
+        next[t] = key_override_index_lower_bound(triggers[t]);
+        end[t]  = next[t];
+        while (end[t] < key_override_index_count && key_overrides[key_override_index[end[t]]]->trigger == triggers[t]) {
+            end[t]++;
+        }
+    }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+    for (;;) {
+        // Merge the buckets, picking the candidate that comes first in key_overrides
+        uint8_t bucket = 3;
+        for (uint8_t t = 0; t < 3; t++) {
+            if (next[t] < end[t] && (bucket == 3 || key_override_index[next[t]] < key_override_index[next[bucket]])) {
+                bucket = t;
+            }
+        }
+        if (bucket == 3) {
+            break;
+        }
+
+        const key_override_t *const override = key_overrides[key_override_index[next[bucket]++]];
+        if (override_can_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod);
+        }
+    }
+
+    *activated = false;
+
+    return true;
+}
+#endif
+
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
+
+#ifdef KEY_OVERRIDE_INDEX_SIZE
+    if (key_override_index_update()) {
+        return try_activating_indexed_override(keycode, layer, key_down, is_mod, active_mods, activated);
+    }
+#endif
+
+    for (uint8_t i = 0;; i++) {
+        const key_override_t *const override = key_overrides[i];
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        if (override_can_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod);
+        }
     }
 
     *activated = false;
@@ -34,6 +34,114 @@ uint16_t leader_time = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#    ifdef LEADER_SEQUENCE_COUNT
+#        if LEADER_SEQUENCE_COUNT > 255
+#            error "LEADER_SEQUENCE_COUNT can be at most 255"
+#        endif
+
+// Positions within leader_sequences, sorted by their keys. Sequences sharing a prefix are next to each other, so walking down the trie only narrows a range of this index.
+static uint8_t leader_index[LEADER_SEQUENCE_COUNT];
+static bool    leader_index_built = false;
+// Sequences that start with the keys pressed so far
+static uint8_t leader_first = 0;
+static uint8_t leader_last  = 0;
+
+static inline uint16_t leader_key_at(uint8_t entry, uint8_t depth) {
+    if (depth >= LEADER_SEQUENCE_LENGTH) {
+        return KC_NO;
+    }
+    return pgm_read_word(&leader_sequences[leader_index[entry]].keys[depth]);
+}
+
+static bool leader_sequence_less(uint8_t a, uint8_t b) {
+    for (uint8_t i = 0; i < LEADER_SEQUENCE_LENGTH; i++) {
+        uint16_t key_a = pgm_read_word(&leader_sequences[a].keys[i]);
+        uint16_t key_b = pgm_read_word(&leader_sequences[b].keys[i]);
+        if (key_a != key_b) {
+            return key_a < key_b;
+        }
+    }
+    return false;
+}
+
+static void leader_index_build(void) {
+    // Insertion sort, stable so that the first of two identical sequences wins
+    for (uint8_t i = 0; i < LEADER_SEQUENCE_COUNT; i++) {
+        uint8_t j = i;
+        while (j > 0 && leader_sequence_less(i, leader_index[j - 1])) {
+            leader_index[j] = leader_index[j - 1];
+            j--;
+        }
+        leader_index[j] = i;
+    }
+    leader_index_built = true;
+}
+
+/** Returns the first entry within [first, last) whose key at `depth` is not less than (or with `upper`, greater than) `keycode` */
+static uint8_t leader_bound(uint8_t first, uint8_t last, uint8_t depth, uint16_t keycode, bool upper) {
+    uint8_t count = last - first;
+    while (count > 0) {
+        uint8_t  step = count / 2;
+        uint16_t key  = leader_key_at(first + step, depth);
+        if (key < keycode || (upper && key == keycode)) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+static void leader_finish(uint8_t entry) {
+    leading = false;
+    if (entry < LEADER_SEQUENCE_COUNT) {
+        void (*action)(void) = (void (*)(void))pgm_read_ptr(&leader_sequences[leader_index[entry]].action);
+        if (action) {
+            action();
+        }
+    }
+    leader_end();
+}
+
+/** The sequence typed so far, if it is a complete sequence itself. Because KC_NO sorts first, it is the first of the range. */
+static bool leader_has_exact_match(void) {
+    return leader_first < leader_last && leader_key_at(leader_first, leader_sequence_size) == KC_NO;
+}
+
+/** Walks one key down the trie. Finishes the sequence right away when the keys can't be continued any more. */
+static void leader_advance(uint16_t keycode) {
+    uint8_t depth = leader_sequence_size - 1;
+
+    leader_first = leader_bound(leader_first, leader_last, depth, keycode, false);
+    leader_last  = leader_bound(leader_first, leader_last, depth, keycode, true);
+
+    if (leader_first == leader_last) {
+        // Nothing starts like this
+        leader_finish(LEADER_SEQUENCE_COUNT);
+    } else if (leader_has_exact_match() && (leader_last - leader_first == 1 || leader_sequence_size == LEADER_SEQUENCE_LENGTH)) {
+        // Nothing longer starts like this
+        leader_finish(leader_first);
+    }
+}
+
+void leader_task(void) {
+    if (!leading) {
+        return;
+    }
+#        ifdef LEADER_NO_TIMEOUT
+    if (leader_sequence_size == 0) {
+        return;
+    }
+#        endif
+    if (timer_elapsed(leader_time) > LEADER_TIMEOUT) {
+        leader_finish(leader_has_exact_match() ? leader_first : LEADER_SEQUENCE_COUNT);
+    }
+}
+#    else
+void leader_task(void) {}
+#    endif // LEADER_SEQUENCE_COUNT
+
 void qk_leader_start(void) {
     if (leading) {
         return;
@@ -43,6 +151,13 @@ void qk_leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#    ifdef LEADER_SEQUENCE_COUNT
+    if (!leader_index_built) {
+        leader_index_build();
+    }
+    leader_first = 0;
+    leader_last  = LEADER_SEQUENCE_COUNT;
+#    endif
 }
 
 bool process_leader(uint16_t keycode, keyrecord_t *record) {
@@ -61,6 +176,9 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                 if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
                     leader_sequence[leader_sequence_size] = keycode;
                     leader_sequence_size++;
+#    ifdef LEADER_SEQUENCE_COUNT
+                    leader_advance(keycode);
+#    endif
                 } else {
                     leading = false;
                     leader_end();
@@ -23,6 +23,24 @@ bool process_leader(uint16_t keycode, keyrecord_t *record);
 void leader_start(void);
 void leader_end(void);
 void qk_leader_start(void);
+void leader_task(void);
+
+/** Maximum number of keys in a leader sequence */
+#define LEADER_SEQUENCE_LENGTH 5
+
+/** A leader sequence and the function to run once it has been typed. Unused trailing keys are KC_NO. */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_LENGTH];
+    void (*action)(void);
+} leader_sequence_t;
+
+#define LEADER_SEQUENCE(function, ...) \
+    { .keys = {__VA_ARGS__}, .action = (function) }
+
+#ifdef LEADER_SEQUENCE_COUNT
+/** Define this in your keymap to match sequences as they are typed, instead of using LEADER_DICTIONARY() */
+extern const leader_sequence_t PROGMEM leader_sequences[LEADER_SEQUENCE_COUNT];
+#endif
 
 #define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
@@ -81,7 +81,12 @@ void persist_unicode_input_mode(void) {
     eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
-__attribute__((weak)) void unicode_input_start(void) {
+/* Unicode input is split into a session, which takes care of the mods
+ * and lock keys, and the input of each character within it. A single
+ * character is a session of its own, while UNICODE_BATCH_STRINGS lets
+ * send_unicode_string() type a whole string in one session.
+ */
+static void unicode_session_start(void) {
     unicode_saved_caps_lock = host_keyboard_led_state().caps_lock;
     unicode_saved_num_lock  = host_keyboard_led_state().num_lock;
 
@@ -97,6 +102,30 @@ __attribute__((weak)) void unicode_input_start(void) {
     clear_mods();                    // Unregister mods to start from a clean state
     clear_weak_mods();
 
+    // For increased reliability, use numpad keys for inputting digits
+    if (unicode_config.input_mode == UC_WIN && !unicode_saved_num_lock) {
+        tap_code(KC_NUM_LOCK);
+    }
+}
+
+static void unicode_session_finish(void) {
+    switch (unicode_config.input_mode) {
+        case UC_LNX:
+            if (unicode_saved_caps_lock) {
+                tap_code(KC_CAPS_LOCK);
+            }
+            break;
+        case UC_WIN:
+            if (!unicode_saved_num_lock) {
+                tap_code(KC_NUM_LOCK);
+            }
+            break;
+    }
+
+    set_mods(unicode_saved_mods); // Reregister previously set mods
+}
+
+static void unicode_char_start(void) {
     switch (unicode_config.input_mode) {
         case UC_MAC:
             register_code(UNICODE_KEY_MAC);
@@ -105,10 +134,6 @@ __attribute__((weak)) void unicode_input_start(void) {
             tap_code16(UNICODE_KEY_LNX);
             break;
         case UC_WIN:
-            // For increased reliability, use numpad keys for inputting digits
-            if (!unicode_saved_num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             register_code(KC_LEFT_ALT);
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
@@ -122,29 +147,31 @@ __attribute__((weak)) void unicode_input_start(void) {
     wait_ms(UNICODE_TYPE_DELAY);
 }
 
-__attribute__((weak)) void unicode_input_finish(void) {
+static void unicode_char_finish(void) {
     switch (unicode_config.input_mode) {
         case UC_MAC:
             unregister_code(UNICODE_KEY_MAC);
             break;
         case UC_LNX:
             tap_code(KC_SPACE);
-            if (unicode_saved_caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UC_WIN:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UC_WINC:
             tap_code(KC_ENTER);
             break;
     }
+}
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+__attribute__((weak)) void unicode_input_start(void) {
+    unicode_session_start();
+    unicode_char_start();
+}
+
+__attribute__((weak)) void unicode_input_finish(void) {
+    unicode_char_finish();
+    unicode_session_finish();
 }
 
 __attribute__((weak)) void unicode_input_cancel(void) {
@@ -231,6 +258,126 @@ void register_unicode(uint32_t code_point) {
     unicode_input_finish();
 }
 
+#ifdef UNICODE_BATCH_STRINGS
+// Longest hex sequence typed for one character: a UTF-16 surrogate pair on macOS
+#    define UNICODE_HEX_MAX_DIGITS 8
+
+/**
+ * Fills `digits` with the hex digits typed for a code point, the same ones
+ * register_unicode() would type, and returns how many there are.
+ */
+static uint8_t unicode_hex_digits(uint32_t code_point, char *digits) {
+    uint32_t hex[2]  = {code_point, 0};
+    uint8_t  count   = 0;
+    uint8_t  numbers = 1;
+
+    if (code_point > 0xFFFF && unicode_config.input_mode == UC_MAC) {
+        // Convert code point to UTF-16 surrogate pair on macOS
+        code_point -= 0x10000;
+        hex[0]  = ((code_point & 0xFFC00) >> 10) + 0xD800;
+        hex[1]  = (code_point & 0x3FF) + 0xDC00;
+        numbers = 2;
+    }
+
+    for (uint8_t n = 0; n < numbers; n++) {
+        bool leading = true;
+        for (int8_t i = 7; i >= 0; i--) {
+            uint8_t digit = (hex[n] >> (i * 4)) & 0xF;
+            if (digit || i <= 3 || !leading) {
+                digits[count++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+                leading         = false;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Returns the keycode that types a hex digit on its own, or KC_NO if the
+ * digit needs modifiers on the current keymap language.
+ */
+static uint8_t unicode_digit_keycode(char digit) {
+    if (unicode_config.input_mode == UC_WIN) {
+        return digit <= '9' ? KC_KP_1 + (10 + digit - '0' - 1) % 10 : KC_A + (digit - 'a');
+    }
+
+    uint8_t index = (uint8_t)digit / 8;
+    uint8_t mask  = 1 << ((uint8_t)digit % 8);
+    if ((pgm_read_byte(&ascii_to_shift_lut[index]) | pgm_read_byte(&ascii_to_altgr_lut[index]) | pgm_read_byte(&ascii_to_dead_lut[index])) & mask) {
+        return KC_NO;
+    }
+    return pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)digit]);
+}
+
+/**
+ * Types hex digits with one report per digit, rather than a press and a
+ * release report each: a digit is released in the same report that presses
+ * the next one. Repeated digits still need a release in between.
+ */
+static void unicode_tap_digits(const char *digits, uint8_t count) {
+    uint8_t held = KC_NO;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t keycode = unicode_digit_keycode(digits[i]);
+
+        if (held != KC_NO && (keycode == KC_NO || keycode == held)) {
+            del_key(held);
+            send_keyboard_report();
+            wait_ms(TAP_CODE_DELAY);
+            held = KC_NO;
+        }
+
+        if (keycode == KC_NO) {
+            send_char(digits[i]);
+            continue;
+        }
+
+        if (held != KC_NO) {
+            del_key(held);
+        }
+        add_key(keycode);
+        send_keyboard_report();
+        wait_ms(TAP_CODE_DELAY);
+        held = keycode;
+    }
+
+    if (held != KC_NO) {
+        del_key(held);
+        send_keyboard_report();
+    }
+}
+
+void send_unicode_string(const char *str) {
+    if (!str) {
+        return;
+    }
+
+    bool in_session = false;
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+
+        if (code_point < 0 || code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UC_WIN)) {
+            continue;
+        }
+
+        char    digits[UNICODE_HEX_MAX_DIGITS];
+        uint8_t count = unicode_hex_digits(code_point, digits);
+
+        if (!in_session) {
+            unicode_session_start();
+            in_session = true;
+        }
+        unicode_char_start();
+        unicode_tap_digits(digits, count);
+        unicode_char_finish();
+    }
+
+    if (in_session) {
+        unicode_session_finish();
+    }
+}
+#else
 void send_unicode_string(const char *str) {
     if (!str) {
         return;
@@ -245,6 +392,7 @@ void send_unicode_string(const char *str) {
         }
     }
 }
+#endif
 
 // clang-format off
 
@@ -207,128 +207,180 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == KC_LEAD) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
-#endif
-
-#ifdef VELOCIKEY_ENABLE
-    if (velocikey_enabled() && record->event.pressed) {
-        velocikey_accelerate();
-    }
-#endif
-
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
+typedef bool (*process_record_handler_func_t)(uint16_t keycode, keyrecord_t *record);
+
+typedef struct {
+    uint16_t                     first;
+    uint16_t                     last;
+    process_record_handler_func_t process;
+} process_record_handler_t;
+
+// Handlers that look at every record, e.g. to record or interrupt sequences
+#define PROCESS_ALWAYS(process) \
+    { 0, UINT16_MAX, process }
+// Handlers that only act on keycodes within first ... last
+#define PROCESS_RANGE(first, last, process) \
+    { first, last, process }
+// Handlers that only act on keycodes of the quantum block, up to SAFE_RANGE
+#define PROCESS_QUANTUM(process) PROCESS_RANGE(QK_BOOTLOADER, SAFE_RANGE - 1, process)
+
+// Adapters for handlers taking a const record
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_record(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
-
-#ifdef TAP_DANCE_ENABLE
-    preprocess_tap_dance(keycode, record);
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_record(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
 #endif
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* Keycode handlers in the order they get to process a record.
+   A record is only passed to the handlers whose range contains its keycode, so basic
+   keycodes don't pay for a call into every enabled feature.                          */
+static const process_record_handler_t PROGMEM process_record_handler_table[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_ALWAYS(process_dynamic_macro),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_ALWAYS(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_ALWAYS(process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_ALWAYS(process_record_via),
 #endif
-            process_record_kb(keycode, record) &&
+    PROCESS_ALWAYS(process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_ALWAYS(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_QUANTUM(process_sequencer),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_QUANTUM(process_midi),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_QUANTUM(process_audio),
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_QUANTUM(process_backlight),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RANGE(QK_STENO, QK_STENO_MAX, process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_ALWAYS(process_music),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_ALWAYS(process_key_override_record),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_ALWAYS(process_tap_dance),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_ALWAYS(process_caps_word),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    PROCESS_ALWAYS(process_unicode_common),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_ALWAYS(process_leader),
 #endif
 #ifdef PRINTING_ENABLE
-            process_printer(keycode, record) &&
+    PROCESS_ALWAYS(process_printer),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_ALWAYS(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_QUANTUM(process_dynamic_tapping_term),
 #endif
 #ifdef TERMINAL_ENABLE
-            process_terminal(keycode, record) &&
+    PROCESS_ALWAYS(process_terminal),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_ALWAYS(process_space_cadet),
 #endif
 #ifdef MAGIC_KEYCODE_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_QUANTUM(process_magic),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RANGE(QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, process_grave_esc),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    PROCESS_QUANTUM(process_rgb_record),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RANGE(JS_BUTTON0, JS_BUTTON_MAX, process_joystick),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RANGE(PROGRAMMABLE_BUTTON_MIN, PROGRAMMABLE_BUTTON_MAX, process_programmable_button),
 #endif
-            true)) {
+};
+
+/* Runs the record through the handler table, stopping at the first handler returning false */
+static bool process_record_handlers(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < sizeof(process_record_handler_table) / sizeof(process_record_handler_table[0]); i++) {
+        const process_record_handler_t *handler = &process_record_handler_table[i];
+        if (keycode < pgm_read_word(&handler->first) || keycode > pgm_read_word(&handler->last)) {
+            continue;
+        }
+        process_record_handler_func_t process = (process_record_handler_func_t)pgm_read_ptr(&handler->process);
+        if (!process(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == KC_LEAD) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef VELOCIKEY_ENABLE
+    if (velocikey_enabled() && record->event.pressed) {
+        velocikey_accelerate();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    preprocess_tap_dance(keycode, record);
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
+#endif
+
+    if (!process_record_handlers(keycode, record)) {
         return false;
     }
 
@@ -8,21 +8,28 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+
+    // Every key without a recent hit has the same color, so work it out once
+    HSV base_hsv = effect_func(rgb_matrix_config.hsv, scale16by8(max_tick, qadd8(rgb_matrix_config.speed, 1)));
+    RGB base;
+    rgb_matrix_hsv_to_rgb_span(&base_hsv, &base, 1);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        uint16_t tick = max_tick;
-        // Reverse search to find most recent key hit
-        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
-            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
-                tick = g_last_hit_tracker.tick[j];
-                break;
-            }
-        }
-
-        uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
-        RGB      rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_set_color(i, base.r, base.g, base.b);
+    }
+
+    // Then draw the hits over it, oldest first, so the most recent hit of a key ends up on top
+    hsv_span_t span;
+    span.count = 0;
+    for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+        uint8_t i = g_last_hit_tracker.index[j];
+        if (i < led_min || i >= led_max || g_last_hit_tracker.tick[j] >= max_tick) continue;
+        RGB_MATRIX_TEST_LED_FLAGS();
+
+        uint16_t offset = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        hsv_span_push(&span, i, effect_func(rgb_matrix_config.hsv, offset));
     }
+    hsv_span_flush(&span);
     return rgb_matrix_check_finished_leds(led_max);
 }
 
@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef RGB_MATRIX_HSV_SPAN_SIZE
+#    define RGB_MATRIX_HSV_SPAN_SIZE 16
+#endif
+
+/* Colors of consecutive LEDs, converted to RGB together once the span is full
+ * or the effect is done with the LEDs of this pass.
+ */
+typedef struct {
+    HSV     hsv[RGB_MATRIX_HSV_SPAN_SIZE];
+    uint8_t index[RGB_MATRIX_HSV_SPAN_SIZE];
+    uint8_t count;
+} hsv_span_t;
+
+static void hsv_span_flush(hsv_span_t* span) {
+    RGB rgb[RGB_MATRIX_HSV_SPAN_SIZE];
+    rgb_matrix_hsv_to_rgb_span(span->hsv, rgb, span->count);
+    for (uint8_t k = 0; k < span->count; k++) {
+        rgb_matrix_set_color(span->index[k], rgb[k].r, rgb[k].g, rgb[k].b);
+    }
+    span->count = 0;
+}
+
+static inline void hsv_span_push(hsv_span_t* span, uint8_t i, HSV hsv) {
+    span->hsv[span->count]   = hsv;
+    span->index[span->count] = i;
+    if (++span->count == RGB_MATRIX_HSV_SPAN_SIZE) {
+        hsv_span_flush(span);
+    }
+}
@@ -6,30 +6,44 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #            define RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS 25
 #        endif
 
+// The cells of g_rgb_frame_buffer that are not zero, as col * MATRIX_ROWS + row, so that
+// decay and rendering only touch the keys that were typed on recently.
+static uint8_t heatmap_active_cells[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t heatmap_active_count;
+// Where in heatmap_active_cells the next iteration of the effect carries on rendering.
+static uint8_t heatmap_render_pos;
+
+static void heatmap_add(uint8_t row, uint8_t col, uint8_t amount) {
+    if (g_rgb_frame_buffer[row][col] == 0) {
+        heatmap_active_cells[heatmap_active_count++] = col * MATRIX_ROWS + row;
+    }
+    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], amount);
+}
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
+    heatmap_add(row, col, 32);
 #        else
     uint8_t m_row = row - 1;
     uint8_t p_row = row + 1;
     uint8_t m_col = col - 1;
     uint8_t p_col = col + 1;
 
-    if (m_col < col) g_rgb_frame_buffer[row][m_col] = qadd8(g_rgb_frame_buffer[row][m_col], 16);
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-    if (p_col < MATRIX_COLS) g_rgb_frame_buffer[row][p_col] = qadd8(g_rgb_frame_buffer[row][p_col], 16);
+    if (m_col < col) heatmap_add(row, m_col, 16);
+    heatmap_add(row, col, 32);
+    if (p_col < MATRIX_COLS) heatmap_add(row, p_col, 16);
 
     if (p_row < MATRIX_ROWS) {
-        if (m_col < col) g_rgb_frame_buffer[p_row][m_col] = qadd8(g_rgb_frame_buffer[p_row][m_col], 13);
-        g_rgb_frame_buffer[p_row][col] = qadd8(g_rgb_frame_buffer[p_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[p_row][p_col] = qadd8(g_rgb_frame_buffer[p_row][p_col], 13);
+        if (m_col < col) heatmap_add(p_row, m_col, 13);
+        heatmap_add(p_row, col, 16);
+        if (p_col < MATRIX_COLS) heatmap_add(p_row, p_col, 13);
     }
 
     if (m_row < row) {
-        if (m_col < col) g_rgb_frame_buffer[m_row][m_col] = qadd8(g_rgb_frame_buffer[m_row][m_col], 13);
-        g_rgb_frame_buffer[m_row][col] = qadd8(g_rgb_frame_buffer[m_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[m_row][p_col] = qadd8(g_rgb_frame_buffer[m_row][p_col], 13);
+        if (m_col < col) heatmap_add(m_row, m_col, 13);
+        heatmap_add(m_row, col, 16);
+        if (p_col < MATRIX_COLS) heatmap_add(m_row, p_col, 13);
     }
 #        endif
 }
@@ -40,14 +54,10 @@ static uint16_t heatmap_decrease_timer;
 static bool decrease_heatmap_values;
 
 bool TYPING_HEATMAP(effect_params_t* params) {
-    // Modified version of RGB_MATRIX_USE_LIMITS to work off of matrix row / col size
-    uint8_t led_min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;
-    uint8_t led_max = led_min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (led_max > sizeof(g_rgb_frame_buffer)) led_max = sizeof(g_rgb_frame_buffer);
-
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_active_count = 0;
     }
 
     // The heatmap animation might run in several iterations depending on
@@ -60,31 +70,43 @@ bool TYPING_HEATMAP(effect_params_t* params) {
         if (decrease_heatmap_values) {
             heatmap_decrease_timer = timer_read();
         }
+
+        // Cells that are zero render as black, so only the active ones need drawing over that.
+        rgb_matrix_set_color_all(0, 0, 0);
+        heatmap_render_pos = 0;
     }
 
-    // Render heatmap & decrease
-    for (int i = led_min; i < led_max; i++) {
-        uint8_t row = i % MATRIX_ROWS;
-        uint8_t col = i / MATRIX_ROWS;
-        uint8_t val = g_rgb_frame_buffer[row][col];
+    // Render heatmap & decrease, up to RGB_MATRIX_LED_PROCESS_LIMIT active cells per iteration
+    for (uint8_t processed = 0; processed < RGB_MATRIX_LED_PROCESS_LIMIT && heatmap_render_pos < heatmap_active_count; processed++) {
+        uint8_t cell = heatmap_active_cells[heatmap_render_pos];
+        uint8_t row  = cell % MATRIX_ROWS;
+        uint8_t col  = cell / MATRIX_ROWS;
+        uint8_t val  = g_rgb_frame_buffer[row][col];
 
         // set the pixel colour
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+
         uint8_t led[LED_HITS_TO_REMEMBER];
         uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
         for (uint8_t j = 0; j < led_count; ++j) {
             if (!HAS_ANY_FLAGS(g_led_config.flags[led[j]], params->flags)) continue;
-
-            HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-            RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
             rgb_matrix_set_color(led[j], rgb.r, rgb.g, rgb.b);
         }
 
         if (decrease_heatmap_values) {
             g_rgb_frame_buffer[row][col] = qsub8(val, 1);
         }
+
+        if (g_rgb_frame_buffer[row][col] == 0) {
+            // Drop the cell by moving the last one into its place, which then gets rendered next
+            heatmap_active_cells[heatmap_render_pos] = heatmap_active_cells[--heatmap_active_count];
+        } else {
+            heatmap_render_pos++;
+        }
     }
 
-    return led_max < sizeof(g_rgb_frame_buffer);
+    return heatmap_render_pos < heatmap_active_count;
 }
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -35,6 +35,18 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Used by the effect runners. Goes through rgb_matrix_hsv_to_rgb() so overrides of it still apply,
+// unless RGB_MATRIX_HSV_SPAN_FAST says the plain conversion can be used for the whole span.
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_span(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef RGB_MATRIX_HSV_SPAN_FAST
+    hsv_to_rgb_span(hsv, rgb, count);
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+#endif
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -253,6 +253,12 @@ static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
 
+#ifdef RGB_MATRIX_TEST_DRIVER
+// The last flushed frame, and the number of frames flushed since init
+extern RGB      rgb_matrix_test_frame[DRIVER_LED_TOTAL];
+extern uint32_t rgb_matrix_test_frame_count;
+#endif
+
 extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
@@ -380,4 +380,43 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .set_color     = setled,
     .set_color_all = setled_all,
 };
+
+#elif defined(RGB_MATRIX_TEST_DRIVER)
+#    include <string.h>
+
+// Captures frames in memory, so effects can be run on the host
+RGB      rgb_matrix_test_frame[DRIVER_LED_TOTAL];
+uint32_t rgb_matrix_test_frame_count;
+
+static RGB rgb_matrix_test_buffer[DRIVER_LED_TOTAL];
+
+static void init(void) {
+    memset(rgb_matrix_test_buffer, 0, sizeof(rgb_matrix_test_buffer));
+    memset(rgb_matrix_test_frame, 0, sizeof(rgb_matrix_test_frame));
+    rgb_matrix_test_frame_count = 0;
+}
+
+static void flush(void) {
+    memcpy(rgb_matrix_test_frame, rgb_matrix_test_buffer, sizeof(rgb_matrix_test_frame));
+    rgb_matrix_test_frame_count++;
+}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    rgb_matrix_test_buffer[index].r = r;
+    rgb_matrix_test_buffer[index].g = g;
+    rgb_matrix_test_buffer[index].b = b;
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
 #endif
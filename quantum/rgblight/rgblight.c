@@ -132,9 +132,59 @@ rgblight_segment_t const *const *rgblight_layers = NULL;
 
 rgblight_ranges_t rgblight_ranges = {0, RGBLED_NUM, 0, RGBLED_NUM, RGBLED_NUM};
 
+#if defined(RGBLIGHT_CUSTOM_DRIVER) && (defined(RGBLIGHT_SKIP_UNCHANGED) || defined(RGBLIGHT_FRAME_STATS))
+#    error "RGBLIGHT_SKIP_UNCHANGED and RGBLIGHT_FRAME_STATS work inside the built in rgblight_set(), and cannot be used with a custom driver"
+#endif
+
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+/* copy of the last frame handed to the driver, so unchanged frames can be skipped */
+static LED_TYPE last_frame[RGBLED_NUM];
+static bool     last_frame_valid = false;
+
+void rgblight_invalidate_frame(void) {
+    last_frame_valid = false;
+}
+#endif
+
+#ifdef RGBLIGHT_FRAME_STATS
+static uint16_t frame_count       = 0;
+static uint16_t push_count        = 0;
+static uint16_t frames_per_second = 0;
+static uint16_t pushes_per_second = 0;
+static uint32_t frame_stats_timer = 0;
+
+static void rgblight_frame_stats_record(bool pushed) {
+    frame_count++;
+    if (pushed) {
+        push_count++;
+    }
+    if (timer_elapsed32(frame_stats_timer) >= 1000) {
+        frames_per_second = frame_count;
+        pushes_per_second = push_count;
+        frame_count       = 0;
+        push_count        = 0;
+        frame_stats_timer = timer_read32();
+    }
+}
+
+uint16_t rgblight_get_frames_per_second(void) {
+    return frames_per_second;
+}
+
+uint16_t rgblight_get_pushes_per_second(void) {
+    return pushes_per_second;
+}
+#    define RGBLIGHT_FRAME_STATS_RECORD(pushed) rgblight_frame_stats_record(pushed)
+#else
+#    define RGBLIGHT_FRAME_STATS_RECORD(pushed)
+#endif
+
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+    rgblight_invalidate_frame();
+#endif
 }
 
 void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
@@ -250,6 +300,10 @@ void rgblight_init(void) {
 
     rgblight_timer_init(); // setup the timer
 
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+    rgblight_invalidate_frame();
+#endif
+
     if (rgblight_config.enable) {
         rgblight_mode_noeeprom(rgblight_config.mode);
     }
@@ -880,6 +934,10 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_SKIP_UNCHANGED
+    // the LEDs may have lost power while suspended
+    rgblight_invalidate_frame();
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -944,6 +1002,17 @@ void rgblight_set(void) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
 #    endif
+
+#    ifdef RGBLIGHT_SKIP_UNCHANGED
+    if (last_frame_valid && memcmp(last_frame, start_led, sizeof(LED_TYPE) * num_leds) == 0) {
+        RGBLIGHT_FRAME_STATS_RECORD(false);
+        return;
+    }
+    memcpy(last_frame, start_led, sizeof(LED_TYPE) * num_leds);
+    last_frame_valid = true;
+#    endif
+
+    RGBLIGHT_FRAME_STATS_RECORD(true);
     rgblight_call_driver(start_led, num_leds);
 }
 #endif
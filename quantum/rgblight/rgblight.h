@@ -302,6 +302,13 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 
 /* === Low level Functions === */
 void rgblight_set(void);
+#ifdef RGBLIGHT_SKIP_UNCHANGED
+void rgblight_invalidate_frame(void);
+#endif
+#ifdef RGBLIGHT_FRAME_STATS
+uint16_t rgblight_get_frames_per_second(void);
+uint16_t rgblight_get_pushes_per_second(void);
+#endif
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
 
 /* === Effects and Animations Functions === */
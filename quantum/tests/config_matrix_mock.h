@@ -0,0 +1,24 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 3
+
+#define MATRIX_ROW_PINS \
+    { 0, 1, 2, 3 }
+#define MATRIX_COL_PINS \
+    { 4, 5, 6 }
+#define DIODE_DIRECTION COL2ROW
+
+#define MATRIX_IDLE_TIMEOUT 50
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "matrix_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,24 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 8
+
+/* Rows on port 0. Columns cover a contiguous run (9-11), a second and third port (20, 24),
+ * a run in reversed order (13, 12) and a gap in an otherwise contiguous port (15). */
+#define MATRIX_ROW_PINS \
+    { 0, 1, 2, 3 }
+#define MATRIX_COL_PINS \
+    { 9, 10, 11, 20, 13, 12, 24, 15 }
+#define DIODE_DIRECTION COL2ROW
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "matrix_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
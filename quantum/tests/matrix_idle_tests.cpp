@@ -0,0 +1,113 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+
+uint8_t idle_enters = 0;
+uint8_t idle_exits  = 0;
+
+void matrix_idle_enter_kb(void) {
+    idle_enters++;
+}
+
+void matrix_idle_exit_kb(void) {
+    idle_exits++;
+}
+}
+
+class MatrixIdle : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                mock_set_key(row, col, false);
+            }
+        }
+        mock_matrix_activity_elapsed = 0;
+        matrix_init();
+        idle_enters = 0;
+        idle_exits  = 0;
+    }
+
+    void enter_idle(void) {
+        matrix_scan();
+        mock_matrix_activity_elapsed = MATRIX_IDLE_TIMEOUT;
+        matrix_scan();
+        ASSERT_TRUE(matrix_is_idle());
+        mock_pin_reads();
+    }
+};
+
+TEST_F(MatrixIdle, EntersAfterTimeout) {
+    matrix_scan();
+    EXPECT_FALSE(matrix_is_idle());
+
+    mock_matrix_activity_elapsed = MATRIX_IDLE_TIMEOUT - 1;
+    matrix_scan();
+    EXPECT_FALSE(matrix_is_idle());
+
+    mock_matrix_activity_elapsed = MATRIX_IDLE_TIMEOUT;
+    matrix_scan();
+    EXPECT_TRUE(matrix_is_idle());
+    EXPECT_EQ(idle_enters, 1);
+    EXPECT_EQ(idle_exits, 0);
+}
+
+TEST_F(MatrixIdle, NotWhileKeyHeld) {
+    mock_set_key(2, 1, true);
+    matrix_scan();
+
+    mock_matrix_activity_elapsed = MATRIX_IDLE_TIMEOUT * 2;
+    matrix_scan();
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_EQ(idle_enters, 0);
+    EXPECT_EQ(matrix[2], 1 << 1);
+}
+
+TEST_F(MatrixIdle, OnlyReadsColumnsWhileIdle) {
+    enter_idle();
+
+    EXPECT_EQ(matrix_scan(), 0);
+    EXPECT_EQ(mock_pin_reads(), MATRIX_COLS);
+    EXPECT_TRUE(matrix_is_idle());
+}
+
+TEST_F(MatrixIdle, KeyPressExitsInSameScan) {
+    enter_idle();
+
+    mock_set_key(3, 2, true);
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_EQ(idle_exits, 1);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], row == 3 ? 1 << 2 : 0) << "row " << (int)row;
+    }
+
+    // releasing the key is seen by the full scan, and idle mode is entered again after the timeout
+    mock_set_key(3, 2, false);
+    mock_matrix_activity_elapsed = 0;
+    EXPECT_EQ(matrix_scan(), 1);
+    EXPECT_EQ(matrix[3], 0);
+    mock_matrix_activity_elapsed = MATRIX_IDLE_TIMEOUT;
+    matrix_scan();
+    EXPECT_TRUE(matrix_is_idle());
+    EXPECT_EQ(idle_enters, 2);
+}
@@ -0,0 +1,92 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_mock.h"
+#include "matrix.h"
+#include "debounce.h"
+
+static const pin_t mock_row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t mock_col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static bool     pin_is_output[32];
+static bool     pin_level[32];
+static bool     keys[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t pin_reads;
+
+void mock_set_pin_input_high(pin_t pin) {
+    pin_is_output[pin] = false;
+}
+
+void mock_set_pin_output(pin_t pin) {
+    pin_is_output[pin] = true;
+}
+
+void mock_write_pin(pin_t pin, bool level) {
+    pin_level[pin] = level;
+}
+
+static bool mock_pin_level(pin_t pin) {
+    if (pin_is_output[pin]) {
+        return pin_level[pin];
+    }
+    // a column is pulled low by any pressed key on a row that is driven low
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (mock_col_pins[col] != pin) {
+            continue;
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            if (keys[row][col] && pin_is_output[mock_row_pins[row]] && !pin_level[mock_row_pins[row]]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool mock_read_pin(pin_t pin) {
+    pin_reads++;
+    return mock_pin_level(pin);
+}
+
+port_data_t mock_read_port(port_t port) {
+    port_data_t value = 0;
+    pin_reads++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        value |= (port_data_t)mock_pin_level(port * 8 + bit) << bit;
+    }
+    return value;
+}
+
+void mock_set_key(uint8_t row, uint8_t col, bool pressed) {
+    keys[row][col] = pressed;
+}
+
+uint32_t mock_pin_reads(void) {
+    uint32_t reads = pin_reads;
+    pin_reads      = 0;
+    return reads;
+}
+
+/* The rest of what quantum/matrix.c needs from the keyboard, without debouncing */
+
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+uint32_t mock_matrix_activity_elapsed;
+
+uint32_t last_matrix_activity_elapsed(void) {
+    return mock_matrix_activity_elapsed;
+}
+
+void debounce_init(uint8_t num_rows) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        cooked[row] = raw[row];
+    }
+}
+
+void matrix_output_select_delay(void) {}
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+void matrix_init_quantum(void) {}
+void matrix_scan_quantum(void) {}
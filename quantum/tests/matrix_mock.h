@@ -0,0 +1,37 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t pin_t;
+typedef uint8_t port_t;
+typedef uint8_t port_data_t;
+
+#define IGNORE_ATOMIC_BLOCK
+
+#define setPinInputHigh(pin) mock_set_pin_input_high(pin)
+#define setPinOutput(pin) mock_set_pin_output(pin)
+#define writePinLow(pin) mock_write_pin(pin, false)
+#define writePinHigh(pin) mock_write_pin(pin, true)
+#define readPin(pin) mock_read_pin(pin)
+
+/* Pins are numbered 8 to a port */
+#define getPinPort(pin) ((pin) >> 3)
+#define getPinBit(pin) ((pin)&0x7)
+#define readPort(port) mock_read_port(port)
+
+void        mock_set_pin_input_high(pin_t pin);
+void        mock_set_pin_output(pin_t pin);
+void        mock_write_pin(pin_t pin, bool level);
+bool        mock_read_pin(pin_t pin);
+port_data_t mock_read_port(port_t port);
+
+/* Presses or releases the switch between row and col, which connects the two pins through its diode */
+void mock_set_key(uint8_t row, uint8_t col, bool pressed);
+/* Number of pin or port reads since the last call */
+uint32_t mock_pin_reads(void);
+
+/* What last_matrix_activity_elapsed() returns */
+extern uint32_t mock_matrix_activity_elapsed;
@@ -0,0 +1,87 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+}
+
+/* Built once reading columns pin by pin and once with MATRIX_READ_COLS_BY_PORT, so both paths are held to the same results */
+class MatrixReadCols : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        release_all();
+        matrix_init();
+        mock_pin_reads();
+    }
+
+    void release_all(void) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                mock_set_key(row, col, false);
+            }
+        }
+    }
+};
+
+TEST_F(MatrixReadCols, EveryKeyMapsToItsColumn) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            mock_set_key(row, col, true);
+            matrix_scan();
+            for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+                EXPECT_EQ(matrix[r], r == row ? (matrix_row_t)(1 << col) : 0) << "key " << (int)row << "," << (int)col << " row " << (int)r;
+            }
+            mock_set_key(row, col, false);
+        }
+    }
+}
+
+TEST_F(MatrixReadCols, CombinationsAcrossPorts) {
+    // a contiguous run, a reversed pair and the columns on their own ports, all at once
+    const matrix_row_t pattern = 0b11111111;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        mock_set_key(1, col, true);
+    }
+    mock_set_key(3, 2, true);
+    mock_set_key(3, 5, true);
+    mock_set_key(3, 6, true);
+
+    matrix_scan();
+    EXPECT_EQ(matrix[0], 0);
+    EXPECT_EQ(matrix[1], pattern);
+    EXPECT_EQ(matrix[2], 0);
+    EXPECT_EQ(matrix[3], (1 << 2) | (1 << 5) | (1 << 6));
+
+    release_all();
+    matrix_scan();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], 0);
+    }
+}
+
+TEST_F(MatrixReadCols, ReadsPerScan) {
+    matrix_scan();
+#ifdef MATRIX_READ_COLS_BY_PORT
+    // columns live on ports 1, 2 and 3
+    EXPECT_EQ(mock_pin_reads(), MATRIX_ROWS * 3);
+#else
+    EXPECT_EQ(mock_pin_reads(), MATRIX_ROWS * MATRIX_COLS);
+#endif
+}
@@ -0,0 +1,104 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "pointing_device_accumulator.h"
+}
+
+class PointingDeviceAccumulator : public ::testing::Test {
+   protected:
+    pointing_device_accumulator_t accumulator = {};
+
+    void add(int8_t x, int8_t y, uint8_t buttons = 0) {
+        report_mouse_t sample = {};
+        sample.x              = x;
+        sample.y              = y;
+        sample.buttons        = buttons;
+        pointing_device_accumulator_add(&accumulator, sample);
+    }
+};
+
+TEST_F(PointingDeviceAccumulator, SumsSamplesBetweenDrains) {
+    add(10, -5);
+    add(20, -5);
+    add(-3, 1);
+
+    report_mouse_t report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, 27);
+    EXPECT_EQ(report.y, -9);
+
+    report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, ClampsAndCarriesOver) {
+    for (int i = 0; i < 3; i++) {
+        add(100, -100);
+    }
+
+    report_mouse_t report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, INT8_MAX);
+    EXPECT_EQ(report.y, INT8_MIN);
+
+    report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, INT8_MAX);
+    EXPECT_EQ(report.y, INT8_MIN);
+
+    report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, 300 - 2 * INT8_MAX);
+    EXPECT_EQ(report.y, -300 - 2 * INT8_MIN);
+
+    report = pointing_device_accumulator_drain(&accumulator, report_mouse_t{});
+    EXPECT_EQ(report.x, 0);
+    EXPECT_EQ(report.y, 0);
+}
+
+TEST_F(PointingDeviceAccumulator, SaturatesInsteadOfWrapping) {
+    for (int i = 0; i < 300; i++) {
+        add(INT8_MAX, INT8_MIN);
+    }
+
+    EXPECT_EQ(accumulator.x, INT16_MAX);
+    EXPECT_EQ(accumulator.y, INT16_MIN);
+}
+
+TEST_F(PointingDeviceAccumulator, KeepsOtherButtonsWhileDraining) {
+    report_mouse_t report = {};
+    // Button set by a keycode, not by the sensor
+    report.buttons = 0x04;
+
+    add(1, 0, 0x01);
+    report = pointing_device_accumulator_drain(&accumulator, report);
+    EXPECT_EQ(report.buttons, 0x05);
+
+    // Motion only, sensor button still held
+    add(1, 0, 0x01);
+    report = pointing_device_accumulator_drain(&accumulator, report);
+    EXPECT_EQ(report.buttons, 0x05);
+
+    // Sensor releases its button, the keycode button stays
+    add(0, 0, 0x00);
+    report = pointing_device_accumulator_drain(&accumulator, report);
+    EXPECT_EQ(report.buttons, 0x04);
+
+    // Draining with nothing new keeps the buttons as they are
+    report = pointing_device_accumulator_drain(&accumulator, report);
+    EXPECT_EQ(report.buttons, 0x04);
+    EXPECT_EQ(report.x, 0);
+}
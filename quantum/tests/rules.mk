@@ -0,0 +1,22 @@
+matrix_idle_DEFS := -DMATRIX_IDLE_WAKE
+matrix_idle_CONFIG := $(QUANTUM_PATH)/tests/config_matrix_mock.h
+
+matrix_idle_SRC := \
+	$(QUANTUM_PATH)/tests/matrix_mock.c \
+	$(QUANTUM_PATH)/tests/matrix_idle_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+pointing_device_accumulator_SRC := \
+	$(QUANTUM_PATH)/tests/pointing_device_accumulator_tests.cpp \
+	$(QUANTUM_PATH)/pointing_device_accumulator.c
+
+matrix_read_cols_CONFIG := $(QUANTUM_PATH)/tests/config_matrix_port_mock.h
+
+matrix_read_cols_SRC := \
+	$(QUANTUM_PATH)/tests/matrix_mock.c \
+	$(QUANTUM_PATH)/tests/matrix_read_cols_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_read_cols_by_port_DEFS := -DMATRIX_READ_COLS_BY_PORT
+matrix_read_cols_by_port_CONFIG := $(matrix_read_cols_CONFIG)
+matrix_read_cols_by_port_SRC := $(matrix_read_cols_SRC)
@@ -0,0 +1,5 @@
+TEST_LIST += \
+	matrix_idle \
+	matrix_read_cols \
+	matrix_read_cols_by_port \
+	pointing_device_accumulator
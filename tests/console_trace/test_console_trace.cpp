@@ -0,0 +1,188 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "test_common.hpp"
+
+using testing::ElementsAre;
+
+extern "C" {
+#include "console_trace.h"
+
+void advance_time(uint32_t ms);
+
+extern const char __start_qmk_trace[];
+
+static std::vector<std::vector<uint8_t>> packets;
+static bool                              host_listening = true;
+static uint8_t                           host_room      = UINT8_MAX;
+
+uint8_t console_trace_send(const uint8_t *data, uint8_t length) {
+    if (!host_listening) {
+        return 0;
+    }
+    if (length > host_room) {
+        length = host_room;
+    }
+    packets.emplace_back(data, data + length);
+    return length;
+}
+}
+
+static const uint8_t packet_size = CONSOLE_EPSIZE;
+
+class ConsoleTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        debug_enable   = true;
+        host_listening = true;
+        host_room      = UINT8_MAX;
+        packets.clear();
+        advance_time(10);
+        console_trace_task();
+    }
+
+    void TearDown() override {
+        debug_enable = false;
+    }
+
+    /* What print() ends up doing, through sendchar() */
+    static void text(const char *s) {
+        while (*s) {
+            console_trace_putchar(*s++);
+        }
+    }
+
+    /* Sends everything that is buffered, returns the stream cut to `length` after checking the rest is padding */
+    std::vector<uint8_t> flush(size_t length) {
+        std::vector<uint8_t> stream;
+
+        packets.clear();
+        for (size_t sent = -1; sent != packets.size();) {
+            sent = packets.size();
+            advance_time(10);
+            console_trace_task();
+        }
+        for (auto &packet : packets) {
+            EXPECT_EQ(packet.size(), packet_size);
+            stream.insert(stream.end(), packet.begin(), packet.end());
+        }
+        packets.clear();
+
+        EXPECT_GE(stream.size(), length);
+        EXPECT_LT(stream.size(), length + packet_size);
+        for (size_t i = length; i < stream.size(); i++) {
+            EXPECT_EQ(stream[i], CONSOLE_TRACE_RECORD_PADDING) << "at " << i;
+        }
+        stream.resize(length);
+        return stream;
+    }
+
+    /* Finds the format string a record refers to */
+    static const char *format_string(const std::vector<uint8_t> &stream, size_t record) {
+        return __start_qmk_trace + (stream[record + 1] | stream[record + 2] << 8);
+    }
+};
+
+TEST_F(ConsoleTrace, FormatsOnTheHost) {
+    dprintf("row %u: %d\n", 3, -2);
+
+    auto stream = flush(11);
+    EXPECT_EQ(stream[0], CONSOLE_TRACE_RECORD_FORMAT | 2);
+    EXPECT_STREQ(format_string(stream, 0), "row %u: %d\n");
+    EXPECT_THAT(std::vector<uint8_t>(stream.begin() + 3, stream.end()), ElementsAre(3, 0, 0, 0, 0xFE, 0xFF, 0xFF, 0xFF));
+}
+
+TEST_F(ConsoleTrace, CollectsTextIntoOneRecord) {
+    text("hello\n");
+    text("!");
+
+    EXPECT_THAT(flush(9), ElementsAre(CONSOLE_TRACE_RECORD_TEXT | 6, 'h', 'e', 'l', 'l', 'o', '\n', CONSOLE_TRACE_RECORD_TEXT | 1, '!'));
+}
+
+TEST_F(ConsoleTrace, KeepsTextAndTracesInOrder) {
+    text("a");
+    dprintf("b");
+    text("c");
+
+    auto stream = flush(7);
+    EXPECT_THAT(std::vector<uint8_t>(stream.begin(), stream.begin() + 2), ElementsAre(CONSOLE_TRACE_RECORD_TEXT | 1, 'a'));
+    EXPECT_EQ(stream[2], CONSOLE_TRACE_RECORD_FORMAT);
+    EXPECT_STREQ(format_string(stream, 2), "b");
+    EXPECT_THAT(std::vector<uint8_t>(stream.begin() + 5, stream.end()), ElementsAre(CONSOLE_TRACE_RECORD_TEXT | 1, 'c'));
+}
+
+TEST_F(ConsoleTrace, SendsFullPacketsRightAway) {
+    for (int i = 0; i < 40; i++) {
+        text("x");
+    }
+
+    console_trace_task();
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0][0], CONSOLE_TRACE_RECORD_TEXT | 40);
+    EXPECT_EQ(packets[0][packet_size - 1], 'x');
+
+    // the rest waits until the packet would be filled, or for the flush interval
+    packets.clear();
+    console_trace_task();
+    EXPECT_TRUE(packets.empty());
+    flush(41 - packet_size);
+}
+
+TEST_F(ConsoleTrace, FinishesPartlySentPackets) {
+    for (int i = 0; i < 40; i++) {
+        text("x");
+    }
+
+    host_room = 10;
+    console_trace_task();
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0].size(), 10);
+
+    // the rest of the same packet goes first, nothing is sent twice or skipped
+    host_room = UINT8_MAX;
+    console_trace_task();
+    ASSERT_EQ(packets.size(), 2);
+    std::vector<uint8_t> packet(packets[0]);
+    packet.insert(packet.end(), packets[1].begin(), packets[1].end());
+    ASSERT_EQ(packet.size(), packet_size);
+    EXPECT_EQ(packet[0], CONSOLE_TRACE_RECORD_TEXT | 40);
+    for (size_t i = 1; i < packet_size; i++) {
+        EXPECT_EQ(packet[i], 'x') << "at " << i;
+    }
+    flush(41 - packet_size);
+}
+
+TEST_F(ConsoleTrace, CountsWhatWasDropped) {
+    host_listening = false;
+    for (int i = 0; i < 30; i++) {
+        dprintf("dropped");
+    }
+    advance_time(10);
+    console_trace_task();
+
+    // 21 records fill the 64 byte buffer, the rest is only counted
+    host_listening = true;
+    flush(21 * 3);
+
+    dprintf("next");
+    auto stream = flush(6);
+    EXPECT_THAT(std::vector<uint8_t>(stream.begin(), stream.begin() + 3), ElementsAre(CONSOLE_TRACE_RECORD_DROPPED, 9, 0));
+    EXPECT_STREQ(format_string(stream, 3), "next");
+}
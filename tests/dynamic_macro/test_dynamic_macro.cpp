@@ -0,0 +1,180 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+#include "eeprom.h"
+#include "eeconfig.h"
+}
+
+static int buffer_full;
+
+extern "C" void dynamic_macro_record_key_user(int8_t direction, keyrecord_t *record) {
+    buffer_full++;
+}
+
+class DynamicMacro : public TestFixture {
+   public:
+    KeymapKey key_rec1  = KeymapKey{0, 0, 0, DYN_REC_START1};
+    KeymapKey key_rec2  = KeymapKey{0, 1, 0, DYN_REC_START2};
+    KeymapKey key_stop  = KeymapKey{0, 2, 0, DYN_REC_STOP};
+    KeymapKey key_play1 = KeymapKey{0, 3, 0, DYN_MACRO_PLAY1};
+    KeymapKey key_play2 = KeymapKey{0, 4, 0, DYN_MACRO_PLAY2};
+    KeymapKey key_a     = KeymapKey{0, 5, 0, KC_A};
+    KeymapKey key_b     = KeymapKey{0, 6, 0, KC_B};
+    KeymapKey key_c     = KeymapKey{0, 7, 3, KC_C};
+
+    void SetUp() override {
+        buffer_full = 0;
+        set_keymap({key_rec1, key_rec2, key_stop, key_play1, key_play2, key_a, key_b, key_c});
+    }
+};
+
+TEST_F(DynamicMacro, RecordsAndPlaysMacro1) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_b, key_stop);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, RecordsAndPlaysMacro2) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_C)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec2, key_b, key_c, key_stop);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_play2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, HoldsMoreEventsThanMacroSize) {
+    TestDriver driver;
+    const int  taps = DYNAMIC_MACRO_SIZE;
+
+    /* Clear macro 2 so all of the buffer is available. */
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_rec2, key_stop);
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    for (int i = 0; i < taps; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    EXPECT_EQ(buffer_full, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_A)).Times(taps);
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, StopsRecordingWhenBufferIsFull) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_rec2, key_stop);
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    for (size_t i = 0; i < DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t); i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    EXPECT_GT(buffer_full, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, SavesMacrosToEeprom) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_stop);
+    tap_keys(key_rec2, key_a, key_b, key_stop);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    uint16_t *header = (uint16_t *)(EECONFIG_SIZE);
+    EXPECT_EQ(eeprom_read_word(header), 0xD700 ^ (uint16_t)(DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t)));
+    /* Two events per tap, each event fits a single byte on the test matrix. */
+    EXPECT_EQ(eeprom_read_word(header + 1), 2);
+    EXPECT_EQ(eeprom_read_word(header + 2), 4);
+}
+
+TEST_F(DynamicMacro, LoadsMacroFromErasedEeprom) {
+    TestDriver driver;
+
+    /* An erased EEPROM, where the length of the macro that is not recorded reads as 0xFFFF */
+    for (uintptr_t addr = 0; addr < TOTAL_EEPROM_BYTE_COUNT; addr++) {
+        eeprom_write_byte((uint8_t *)addr, 0xFF);
+    }
+    dynamic_macro_reload();
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_b, key_stop);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* As if the keyboard was power cycled */
+    dynamic_macro_reload();
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
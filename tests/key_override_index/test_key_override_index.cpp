@@ -0,0 +1,133 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+/* The ko_make_xxx initializers use C designators, which C++ doesn't accept out of order */
+static key_override_t make_override(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement, ko_option_t options = ko_options_default) {
+    key_override_t override  = {};
+    override.trigger         = trigger;
+    override.trigger_mods    = trigger_mods;
+    override.layers          = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement     = replacement;
+    override.options         = options;
+    return override;
+}
+
+static const key_override_t shift_a_x     = make_override(MOD_MASK_SHIFT, KC_A, KC_X);
+static const key_override_t shift_b_z     = make_override(MOD_MASK_SHIFT, KC_B, KC_Z);
+static const key_override_t shift_a_c     = make_override(MOD_MASK_SHIFT, KC_A, KC_C);
+static const key_override_t ctrl_a_escape = make_override(MOD_MASK_CTRL, KC_A, KC_ESC);
+/* Only allow the trigger key to activate, so the KC_NO override doesn't fire on the modifier press */
+static const key_override_t shift_none_y = make_override(MOD_MASK_SHIFT, KC_NO, KC_Y, ko_option_activation_trigger_down);
+
+static const key_override_t *trigger_first[] = {&shift_b_z, &shift_a_x, &shift_none_y, &shift_a_c, NULL};
+static const key_override_t *no_key_first[]  = {&shift_b_z, &shift_none_y, &shift_a_x, &shift_a_c, NULL};
+static const key_override_t *overflowing[]   = {&shift_b_z, &ctrl_a_escape, &shift_b_z, &ctrl_a_escape, &shift_a_c, NULL};
+
+class KeyOverrideIndex : public TestFixture {
+   protected:
+    void press_shifted(TestDriver &driver, KeymapKey &key_shift, KeymapKey &key, testing::Matcher<report_keyboard_t &> expected) {
+        EXPECT_REPORT(driver, (KC_LSFT));
+        key_shift.press();
+        run_one_scan_loop();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(expected));
+        key.press();
+        run_one_scan_loop();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        key.release();
+        run_one_scan_loop();
+        key_shift.release();
+        run_one_scan_loop();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+    }
+};
+
+TEST_F(KeyOverrideIndex, TriggeredOverrideKeepsPriority) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey{0, 0, 0, KC_LSFT};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_shift, key_a});
+    key_overrides = trigger_first;
+
+    press_shifted(driver, key_shift, key_a, KeyboardReport(KC_X));
+}
+
+TEST_F(KeyOverrideIndex, NoKeyOverrideKeepsPriority) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey{0, 0, 0, KC_LSFT};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+    KeymapKey  key_d     = KeymapKey{0, 2, 0, KC_D};
+
+    set_keymap({key_shift, key_a, key_d});
+    key_overrides = no_key_first;
+
+    /* The pressed key isn't the trigger of a KC_NO override, so it is sent along with the replacement */
+    press_shifted(driver, key_shift, key_a, KeyboardReport(KC_A, KC_Y));
+
+    /* Keys without an override of their own still see the KC_NO ones */
+    press_shifted(driver, key_shift, key_d, KeyboardReport(KC_D, KC_Y));
+}
+
+TEST_F(KeyOverrideIndex, ModifierActivatesLastKeyDown) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey{0, 0, 0, KC_LSFT};
+    KeymapKey  key_b     = KeymapKey{0, 1, 0, KC_B};
+
+    set_keymap({key_shift, key_b});
+    key_overrides = trigger_first;
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* The replacement is registered once the key repeat delay has passed */
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_Z));
+    key_shift.press();
+    idle_for(500); // KEY_OVERRIDE_REPEAT_DELAY
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_shift.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverrideIndex, FallsBackWhenIndexIsFull) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey{0, 0, 0, KC_LSFT};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_shift, key_a});
+    key_overrides = overflowing;
+
+    press_shifted(driver, key_shift, key_a, KeyboardReport(KC_C));
+}
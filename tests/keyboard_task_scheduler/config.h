@@ -0,0 +1,30 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "test_common.h"
+
+#define KEYBOARD_TASK_SCHEDULER
+#define KEYBOARD_TASK_DEADLINE 50
+
+// Long enough that a held tap-hold key stays unresolved for the whole test
+#define TAPPING_TERM 1000
+
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+// Every rgb_matrix_task() call then moves a frame one step on: start, render, flush and sync
+#define RGB_MATRIX_LED_PROCESS_LIMIT DRIVER_LED_TOTAL
+#define RGB_MATRIX_LED_FLUSH_LIMIT 0
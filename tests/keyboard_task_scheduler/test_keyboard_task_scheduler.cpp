@@ -0,0 +1,79 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+extern "C" {
+led_config_t g_led_config;
+
+/* Called once per rendered frame, which takes four rgb_matrix_task() calls with this config */
+static uint32_t frames = 0;
+
+void rgb_matrix_indicators_user(void) {
+    frames++;
+}
+}
+
+class KeyboardTaskScheduler : public TestFixture {
+   public:
+    TestDriver driver;
+
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        // Let the scheduler see the keyboard as idle
+        idle_for(KEYBOARD_TASK_DEADLINE);
+        frames = 0;
+    }
+};
+
+TEST_F(KeyboardTaskScheduler, RunsEveryPassWhileIdle) {
+    idle_for(KEYBOARD_TASK_DEADLINE * 8);
+    EXPECT_EQ(frames, KEYBOARD_TASK_DEADLINE * 8 / 4);
+}
+
+TEST_F(KeyboardTaskScheduler, HeldBackWhileKeyInFlight) {
+    KeymapKey  mod_tap = KeymapKey(0, 0, 0, SFT_T(KC_A));
+    set_keymap({mod_tap});
+
+    // The tap-hold key stays unresolved for TAPPING_TERM, so only the deadline lets the lighting task run
+    mod_tap.press();
+    idle_for(KEYBOARD_TASK_DEADLINE - 1);
+    EXPECT_EQ(frames, 0);
+
+    // From then on it runs once per deadline, so a frame, which takes four runs, every fourth deadline
+    idle_for(KEYBOARD_TASK_DEADLINE * 8);
+    EXPECT_GE(frames, 1);
+    EXPECT_LE(frames, 3);
+
+    EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    mod_tap.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Back to every pass once the tapping term is over and the matrix has settled
+    idle_for(TAPPING_TERM);
+    frames = 0;
+    idle_for(KEYBOARD_TASK_DEADLINE * 8);
+    EXPECT_EQ(frames, KEYBOARD_TASK_DEADLINE * 8 / 4);
+}
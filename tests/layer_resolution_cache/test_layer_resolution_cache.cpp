@@ -0,0 +1,101 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerResolutionCache : public TestFixture {};
+
+TEST_F(LayerResolutionCache, FollowsLayerState) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 0, 0, KC_A};
+
+    set_keymap({key_a, KeymapKey{1, 0, 0, KC_TRNS}, KeymapKey{2, 0, 0, KC_C}});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Transparent key falls through to layer 0 */
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LayerResolutionCache, FollowsDefaultLayer) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 0, 0, KC_A};
+
+    set_keymap({key_a, KeymapKey{1, 0, 0, KC_B}});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+}
+
+TEST_F(LayerResolutionCache, ClearedOnKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 0, 0, KC_A};
+
+    set_keymap({key_a, KeymapKey{1, 0, 0, KC_TRNS}});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Same layer state, but layer 1 is no longer transparent */
+    set_keymap({key_a, KeymapKey{1, 0, 0, KC_B}});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
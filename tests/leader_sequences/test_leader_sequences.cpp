@@ -0,0 +1,139 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+LEADER_EXTERNS();
+}
+
+static int fired_a, fired_dd, fired_dds, fired_bc;
+
+static void leader_a(void) {
+    fired_a++;
+}
+static void leader_dd(void) {
+    fired_dd++;
+}
+static void leader_dds(void) {
+    fired_dds++;
+}
+static void leader_bc(void) {
+    fired_bc++;
+}
+
+extern "C" const leader_sequence_t PROGMEM leader_sequences[LEADER_SEQUENCE_COUNT] = {
+    LEADER_SEQUENCE(leader_dds, KC_D, KC_D, KC_S),
+    LEADER_SEQUENCE(leader_a, KC_A),
+    LEADER_SEQUENCE(leader_bc, KC_B, KC_C),
+    LEADER_SEQUENCE(leader_dd, KC_D, KC_D),
+};
+
+class LeaderSequences : public TestFixture {
+   public:
+    void SetUp() override {
+        fired_a = fired_dd = fired_dds = fired_bc = 0;
+    }
+};
+
+TEST_F(LeaderSequences, UnambiguousSequenceFiresWithoutTimeout) {
+    TestDriver driver;
+    KeymapKey  key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    KeymapKey  key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lead, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_a);
+    EXPECT_EQ(fired_a, 1);
+    EXPECT_FALSE(leading);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LeaderSequences, PrefixWaitsForTimeout) {
+    TestDriver driver;
+    KeymapKey  key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    KeymapKey  key_d    = KeymapKey{0, 1, 0, KC_D};
+
+    set_keymap({key_lead, key_d});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_d, key_d);
+    EXPECT_EQ(fired_dd, 0);
+    EXPECT_TRUE(leading);
+
+    idle_for(LEADER_TIMEOUT);
+    EXPECT_EQ(fired_dd, 1);
+    EXPECT_EQ(fired_dds, 0);
+    EXPECT_FALSE(leading);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LeaderSequences, LongerSequenceFiresOnLastKey) {
+    TestDriver driver;
+    KeymapKey  key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    KeymapKey  key_d    = KeymapKey{0, 1, 0, KC_D};
+    KeymapKey  key_s    = KeymapKey{0, 2, 0, KC_S};
+
+    set_keymap({key_lead, key_d, key_s});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_d, key_d, key_s);
+    EXPECT_EQ(fired_dds, 1);
+    EXPECT_EQ(fired_dd, 0);
+    EXPECT_FALSE(leading);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LeaderSequences, UnknownSequenceEndsEarly) {
+    TestDriver driver;
+    KeymapKey  key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    KeymapKey  key_b    = KeymapKey{0, 1, 0, KC_B};
+    KeymapKey  key_x    = KeymapKey{0, 2, 0, KC_X};
+
+    set_keymap({key_lead, key_b, key_x});
+
+    /* Nothing continues B X, so the sequence ends and swallows just the keys typed so far */
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_b, key_x);
+    EXPECT_FALSE(leading);
+    EXPECT_EQ(fired_bc, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_x);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LeaderSequences, IncompleteSequenceTimesOut) {
+    TestDriver driver;
+    KeymapKey  key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    KeymapKey  key_b    = KeymapKey{0, 1, 0, KC_B};
+
+    set_keymap({key_lead, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_b);
+    idle_for(LEADER_TIMEOUT);
+    EXPECT_FALSE(leading);
+    EXPECT_EQ(fired_bc, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,91 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class ProcessRecordDispatch : public TestFixture {};
+
+TEST_F(ProcessRecordDispatch, BasicKeycodeReachesAction) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 0, 0, KC_A};
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(ProcessRecordDispatch, RangeHandlersSeeTheirKeycodes) {
+    TestDriver driver;
+    KeymapKey  grave_esc = KeymapKey{0, 0, 0, QK_GRAVE_ESCAPE};
+    KeymapKey  dt_up     = KeymapKey{0, 1, 0, DT_UP};
+
+    set_keymap({grave_esc, dt_up});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    grave_esc.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    grave_esc.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    uint16_t tapping_term = g_tapping_term;
+    EXPECT_NO_REPORT(driver);
+    tap_key(dt_up);
+    EXPECT_EQ(g_tapping_term, tapping_term + DYNAMIC_TAPPING_TERM_INCREMENT);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    g_tapping_term = tapping_term;
+}
+
+TEST_F(ProcessRecordDispatch, AlwaysHandlersSeeAllKeycodes) {
+    TestDriver driver;
+    KeymapKey  caps_word = KeymapKey{0, 0, 0, CAPS_WORD};
+    KeymapKey  key_a     = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({caps_word, key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(caps_word);
+    EXPECT_TRUE(is_caps_word_on());
+
+    /* Caps word has to observe the basic keycode to shift it */
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    key_a.release();
+    run_one_scan_loop();
+    caps_word_off();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
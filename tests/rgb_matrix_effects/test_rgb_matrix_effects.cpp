@@ -0,0 +1,271 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+void advance_time(uint32_t ms);
+
+/* A keyboard with one LED per key, laid out as an evenly spaced grid. */
+led_config_t g_led_config;
+
+/* Stands in for a keyboard limiting brightness, switched on by the tests that check it is honoured. */
+static bool limit_brightness = false;
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    if (limit_brightness) hsv.v /= 2;
+    return hsv_to_rgb(hsv);
+}
+}
+
+static bool led_config_init(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t index                    = row * MATRIX_COLS + col;
+            g_led_config.matrix_co[row][col] = index;
+            g_led_config.point[index]        = {(uint8_t)(col * 224 / (MATRIX_COLS - 1)), (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+            g_led_config.flags[index]        = LED_FLAG_KEYLIGHT;
+        }
+    }
+    return true;
+}
+static bool led_config_ready = led_config_init();
+
+static const char *effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+/* How many frames each effect is run for, can be overridden with RGB_MATRIX_BENCH_FRAMES. */
+static const int default_frames = 200;
+/* Key hits are fed in every few frames, so the reactive effects have something to render. */
+static const int hit_interval = 8;
+
+class RgbMatrixEffects : public TestFixture {
+   public:
+    void SetUp() override {
+        ASSERT_TRUE(led_config_ready);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+    }
+
+    /* Runs rgb_matrix_task() until the next frame is flushed, returns the time spent in it */
+    std::chrono::nanoseconds render_frame(void) {
+        std::chrono::nanoseconds elapsed{0};
+        uint32_t                 frame = rgb_matrix_test_frame_count;
+
+        for (int i = 0; i < 1000 && rgb_matrix_test_frame_count == frame; i++) {
+            auto start = std::chrono::steady_clock::now();
+            rgb_matrix_task();
+            elapsed += std::chrono::steady_clock::now() - start;
+            advance_time(1);
+        }
+        EXPECT_EQ(rgb_matrix_test_frame_count, frame + 1);
+        return elapsed;
+    }
+
+    /* Writes the current frame as a PPM image, drawing every LED as a square at its position */
+    void dump_frame(const std::string &path) {
+        const int   scale = 2, size = 8, width = (224 + size) * scale, height = (64 + size) * scale;
+        std::string image(width * height * 3, '\0');
+
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            const RGB &led = rgb_matrix_test_frame[i];
+            for (int y = 0; y < size * scale; y++) {
+                for (int x = 0; x < size * scale; x++) {
+                    size_t pixel     = ((g_led_config.point[i].y * scale + y) * width + g_led_config.point[i].x * scale + x) * 3;
+                    image[pixel]     = led.r;
+                    image[pixel + 1] = led.g;
+                    image[pixel + 2] = led.b;
+                }
+            }
+        }
+
+        FILE *file = fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr) << path;
+        fprintf(file, "P6\n%d %d\n255\n", width, height);
+        fwrite(image.data(), 1, image.size(), file);
+        fclose(file);
+    }
+};
+
+TEST_F(RgbMatrixEffects, CapturesFrames) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    render_frame();
+    render_frame();
+
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_EQ(rgb_matrix_test_frame[i].r, 255) << "LED " << (int)i;
+        EXPECT_EQ(rgb_matrix_test_frame[i].g, 0) << "LED " << (int)i;
+        EXPECT_EQ(rgb_matrix_test_frame[i].b, 0) << "LED " << (int)i;
+    }
+}
+
+static bool led_is_black(uint8_t i) {
+    return rgb_matrix_test_frame[i].r == 0 && rgb_matrix_test_frame[i].g == 0 && rgb_matrix_test_frame[i].b == 0;
+}
+
+TEST_F(RgbMatrixEffects, TypingHeatmapCoolsDown) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+    render_frame();
+
+    // Hit the same key twice, the second time after it has completely cooled down again
+    for (int round = 0; round < 2; round++) {
+        process_rgb_matrix(1, 1, true);
+        render_frame();
+        EXPECT_FALSE(led_is_black(1 * MATRIX_COLS + 1));
+        EXPECT_FALSE(led_is_black(2 * MATRIX_COLS + 2));
+        EXPECT_TRUE(led_is_black(3 * MATRIX_COLS + 9));
+
+        for (int frame = 0; frame < 100; frame++) {
+            render_frame();
+        }
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            EXPECT_TRUE(led_is_black(i)) << "LED " << (int)i;
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, RunnersHonourHsvToRgbOverride) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    render_frame();
+
+    limit_brightness = true;
+    render_frame();
+    limit_brightness = false;
+
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        const RGB &led = rgb_matrix_test_frame[i];
+        EXPECT_LE(led.r, 128) << "LED " << (int)i;
+        EXPECT_LE(led.g, 128) << "LED " << (int)i;
+        EXPECT_LE(led.b, 128) << "LED " << (int)i;
+    }
+}
+
+/* The conversion as it was before the hue segment lookup, kept to check the faster one against. */
+static RGB reference_hsv_to_rgb(HSV hsv) {
+    RGB      rgb;
+    uint8_t  region, remainder, p, q, t;
+    uint16_t h = hsv.h, s = hsv.s, v = hsv.v;
+
+    if (s == 0) {
+        rgb.r = rgb.g = rgb.b = v;
+        return rgb;
+    }
+
+    region    = h * 6 / 255;
+    remainder = (h * 2 - region * 85) * 3;
+
+    p = (v * (255 - s)) >> 8;
+    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb.r = v, rgb.g = t, rgb.b = p;
+            break;
+        case 1:
+            rgb.r = q, rgb.g = v, rgb.b = p;
+            break;
+        case 2:
+            rgb.r = p, rgb.g = v, rgb.b = t;
+            break;
+        case 3:
+            rgb.r = p, rgb.g = q, rgb.b = v;
+            break;
+        case 4:
+            rgb.r = t, rgb.g = p, rgb.b = v;
+            break;
+        default:
+            rgb.r = v, rgb.g = p, rgb.b = q;
+            break;
+    }
+    return rgb;
+}
+
+TEST(HsvToRgb, MatchesReferenceForEveryColor) {
+    for (uint32_t s = 0; s < 256; s++) {
+        for (uint32_t v = 0; v < 256; v++) {
+            HSV hsv[256];
+            RGB rgb[256];
+            for (uint32_t h = 0; h < 256; h++) {
+                hsv[h] = {(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            // every other color varies saturation and value as well, so both span paths are covered
+            hsv_to_rgb_span(hsv, rgb, 128);
+            for (uint32_t h = 128; h < 256; h += 2) {
+                hsv[h].s = ~s;
+                hsv[h].v = ~v;
+            }
+            hsv_to_rgb_span(hsv + 128, rgb + 128, 128);
+
+            for (uint32_t h = 0; h < 256; h++) {
+                RGB expected = reference_hsv_to_rgb(hsv[h]);
+                RGB single   = hsv_to_rgb_nocie(hsv[h]);
+                ASSERT_TRUE(single.r == expected.r && single.g == expected.g && single.b == expected.b) << "h=" << h << " s=" << (int)hsv[h].s << " v=" << (int)hsv[h].v;
+#ifndef USE_CIE1931_CURVE
+                ASSERT_TRUE(rgb[h].r == expected.r && rgb[h].g == expected.g && rgb[h].b == expected.b) << "span h=" << h << " s=" << (int)hsv[h].s << " v=" << (int)hsv[h].v;
+#endif
+            }
+        }
+    }
+}
+
+/* Renders every effect and prints what a frame costs. Setting RGB_MATRIX_DUMP_DIR
+ * writes each frame to <dir>/<effect>_<frame>.ppm as well.
+ */
+TEST_F(RgbMatrixEffects, FrameCost) {
+    const char *frames_env = getenv("RGB_MATRIX_BENCH_FRAMES");
+    const char *dump_dir   = getenv("RGB_MATRIX_DUMP_DIR");
+    const int   frames     = frames_env ? atoi(frames_env) : default_frames;
+
+    std::cout << std::left << std::setw(32) << "effect" << std::right << std::setw(14) << "ns/frame" << std::setw(14) << "LEDs/us" << std::endl;
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+        EXPECT_EQ(rgb_matrix_get_mode(), mode);
+
+        std::chrono::nanoseconds elapsed{0};
+        for (int frame = 0; frame < frames; frame++) {
+            if (frame % hit_interval == 0) {
+                uint8_t key = (frame / hit_interval * 7) % DRIVER_LED_TOTAL;
+                process_rgb_matrix(key / MATRIX_COLS, key % MATRIX_COLS, true);
+            }
+            elapsed += render_frame();
+
+            if (dump_dir) {
+                char name[16];
+                snprintf(name, sizeof(name), "_%04d.ppm", frame);
+                dump_frame(std::string(dump_dir) + "/" + effect_names[mode] + name);
+            }
+        }
+
+        double ns_per_frame = (double)elapsed.count() / frames;
+        double leds_per_us  = ns_per_frame > 0 ? DRIVER_LED_TOTAL * 1000.0 / ns_per_frame : 0;
+        std::cout << std::left << std::setw(32) << effect_names[mode] << std::right << std::fixed << std::setprecision(0) << std::setw(14) << ns_per_frame << std::setprecision(1) << std::setw(14) << leds_per_us << std::endl;
+    }
+}
@@ -0,0 +1,59 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+static uint16_t driver_pushes = 0;
+
+void rgblight_call_driver(LED_TYPE *start_led, uint8_t num_leds) {
+    driver_pushes++;
+}
+}
+
+class RgblightFrames : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_setrgb(10, 20, 30);
+        driver_pushes = 0;
+    }
+};
+
+TEST_F(RgblightFrames, UnchangedFrameIsSkipped) {
+    rgblight_set();
+    rgblight_set();
+    EXPECT_EQ(driver_pushes, 0);
+}
+
+TEST_F(RgblightFrames, ChangedFrameIsPushed) {
+    rgblight_setrgb_at(1, 2, 3, 0);
+    EXPECT_EQ(driver_pushes, 1);
+
+    rgblight_set();
+    EXPECT_EQ(driver_pushes, 1);
+}
+
+TEST_F(RgblightFrames, InvalidateForcesPush) {
+    rgblight_invalidate_frame();
+    rgblight_set();
+    EXPECT_EQ(driver_pushes, 1);
+
+    rgblight_set();
+    EXPECT_EQ(driver_pushes, 1);
+}
@@ -19,6 +19,7 @@
 #include <string.h>
 
 static matrix_row_t matrix[MATRIX_ROWS] = {};
+static bool         matrix_changed      = false;
 
 void matrix_init(void) {
     clear_all_keys();
@@ -26,8 +27,10 @@ void matrix_init(void) {
 }
 
 uint8_t matrix_scan(void) {
+    bool changed   = matrix_changed;
+    matrix_changed = false;
     matrix_scan_quantum();
-    return 1;
+    return changed;
 }
 
 matrix_row_t matrix_get_row(uint8_t row) {
@@ -42,14 +45,17 @@ void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= 1 << col;
+    matrix_changed = true;
 }
 
 void release_key(uint8_t col, uint8_t row) {
     matrix[row] &= ~(1 << col);
+    matrix_changed = true;
 }
 
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
+    matrix_changed = true;
 }
 
 void led_set(uint8_t usb_led) {}
@@ -0,0 +1,164 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <iostream>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+extern "C" {
+#include "utf8.h"
+}
+
+class UnicodeString : public TestFixture {
+   public:
+    void expect_linux_entry(TestDriver &driver) {
+        EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT, KC_U));
+        EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    void expect_linux_commit(TestDriver &driver) {
+        EXPECT_REPORT(driver, (KC_SPACE));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+};
+
+TEST_F(UnicodeString, LinuxStringIsOneSession) {
+    TestDriver driver;
+    InSequence s;
+
+    set_unicode_input_mode(UC_LNX);
+    driver.set_leds(1 << USB_LED_CAPS_LOCK);
+
+    /* Caps Lock is only turned off and back on once for the whole string. */
+    EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+    EXPECT_EMPTY_REPORT(driver);
+
+    expect_linux_entry(driver);
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_commit(driver);
+
+    expect_linux_entry(driver);
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_commit(driver);
+
+    EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+    EXPECT_EMPTY_REPORT(driver);
+
+    send_unicode_string("é€");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(UnicodeString, WindowsDigitsUseKeypad) {
+    TestDriver driver;
+    InSequence s;
+
+    set_unicode_input_mode(UC_WIN);
+    driver.set_leds(1 << USB_LED_NUM_LOCK);
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_KP_PLUS));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_KP_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_KP_0));
+    EXPECT_REPORT(driver, (KC_LALT, KC_F));
+    EXPECT_REPORT(driver, (KC_LALT, KC_KP_1));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_EMPTY_REPORT(driver);
+
+    send_unicode_string("ñ");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(UnicodeString, MacSendsSurrogatePairs) {
+    TestDriver driver;
+    InSequence s;
+
+    set_unicode_input_mode(UC_MAC);
+
+    /* U+1F600 is typed as D83D DE00 with Option held. */
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT, KC_8));
+    EXPECT_REPORT(driver, (KC_LALT, KC_3));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT, KC_E));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_EMPTY_REPORT(driver);
+
+    send_unicode_string("😀");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(UnicodeString, SkipsInvalidCodePoints) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UC_WIN);
+    driver.set_leds(1 << USB_LED_NUM_LOCK);
+
+    /* Outside the BMP, which Windows can't type. */
+    EXPECT_NO_REPORT(driver);
+    send_unicode_string("😀");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(UnicodeString, BatchingSavesReports) {
+    TestDriver driver;
+    const char snippet[] = "∀x∈ℝ: x²≥0 😀🎉";
+    int        reports   = 0;
+
+    set_unicode_input_mode(UC_LNX);
+    driver.set_leds(1 << USB_LED_CAPS_LOCK);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([&reports](const report_keyboard_t &) { reports++; });
+
+    /* What send_unicode_string() does without UNICODE_BATCH_STRINGS */
+    for (const char *str = snippet; *str;) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+        register_unicode(code_point);
+    }
+    int per_character = reports;
+
+    reports = 0;
+    send_unicode_string(snippet);
+    int batched = reports;
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    std::cout << "reports for \"" << snippet << "\": " << per_character << " per character, " << batched << " batched" << std::endl;
+    /* Caps Lock is only toggled around the whole string, and most digits take one report instead of two */
+    EXPECT_LT(batched, per_character * 3 / 4);
+}
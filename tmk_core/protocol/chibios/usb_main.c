@@ -53,6 +53,10 @@ extern keymap_config_t keymap_config;
 #    include "joystick.h"
 #endif
 
+#ifdef CONSOLE_TRACE_ENABLE
+#    include "console_trace.h"
+#endif
+
 /* ---------------------------------------------------------
  *       Global interface variables and declarations
  * ---------------------------------------------------------
@@ -1038,6 +1042,15 @@ void send_digitizer(report_digitizer_t *report) {
 
 #ifdef CONSOLE_ENABLE
 
+#    ifdef CONSOLE_TRACE_ENABLE
+int8_t sendchar(uint8_t c) {
+    return console_trace_putchar(c);
+}
+
+uint8_t console_trace_send(const uint8_t *data, uint8_t length) {
+    return chnWriteTimeout(&drivers.console_driver.driver, data, length, TIME_IMMEDIATE);
+}
+#    else
 int8_t sendchar(uint8_t c) {
     static bool timed_out = false;
     /* The `timed_out` state is an approximation of the ideal `is_listener_disconnected?` state.
@@ -1066,6 +1079,7 @@ int8_t sendchar(uint8_t c) {
     timed_out                   = (result == 0);
     return result;
 }
+#    endif
 
 // Just a dummy function for now, this could be exposed as a weak function
 // Or connected to the actual QMK console
@@ -1083,6 +1097,10 @@ void console_task(void) {
             console_receive(buffer, size);
         }
     } while (size > 0);
+
+#    ifdef CONSOLE_TRACE_ENABLE
+    console_trace_task();
+#    endif
 }
 
 #endif /* CONSOLE_ENABLE */
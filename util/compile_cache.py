@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Content addressed object cache, shared between keyboards.
+
+Usage: compile_cache.py <cache dir> -- <compiler> -c <flags> <source> -o <object>
+
+The translation unit is preprocessed first. The object is looked up by a hash of the compiler, the flags
+that still matter after preprocessing, and the preprocessed source. That way quantum/, tmk_core/ and
+platform objects built for one keyboard are reused by every other keyboard that ends up with the same
+code, even though their include paths, defines and config.h files differ.
+
+Line markers are left out of the hash, so that headers which only add macros do not prevent a hit. Objects
+taken from the cache can therefore carry the debug line information of the keyboard that first built them;
+the firmware images are not affected.
+
+Every lookup is appended to `stats.log` in the cache directory, which `qmk multibuild` reports on. Each hit
+refreshes the modification time of the entry's metadata, which `qmk multibuild` uses to prune unused entries.
+"""
+import hashlib
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+from tempfile import NamedTemporaryFile
+
+# Options that only influence the preprocessor or the build, and whether they take an argument
+PREPROCESSOR_OPTIONS = {
+    '-D': True,
+    '-U': True,
+    '-I': True,
+    '-include': True,
+    '-imacros': True,
+    '-isystem': True,
+    '-iquote': True,
+    '-MF': True,
+    '-MT': True,
+    '-MQ': True,
+    '-o': True,
+    '-MMD': False,
+    '-MD': False,
+    '-MP': False,
+    '-H': False,
+    '-v': False,
+    '-c': False,
+}
+SOURCE_SUFFIXES = ('.c', '.cc', '.cpp')
+
+
+def parse_command(command):
+    """Splits a compile command into the flags that affect code generation, the object, and the dependency file.
+    """
+    flags = []
+    output = depfile = None
+    args = iter(command[1:])
+
+    for arg in args:
+        if arg in PREPROCESSOR_OPTIONS:
+            value = next(args, None) if PREPROCESSOR_OPTIONS[arg] else None
+            if arg == '-o':
+                output = value
+            elif arg == '-MF':
+                depfile = value
+        elif arg[:2] in ('-D', '-U', '-I'):
+            continue
+        elif not arg.startswith('-') and arg.endswith(SOURCE_SUFFIXES):
+            continue
+        else:
+            flags.append(arg)
+
+    return flags, output, depfile
+
+
+def preprocess(command, output, depfile):
+    """Runs the preprocessor, which also writes the dependency file the build expects.
+    """
+    args = []
+    skip = False
+    for arg in command:
+        if skip:
+            skip = False
+        elif arg == '-o':
+            skip = True
+        elif arg not in ('-c', '-H', '-v'):
+            args.append(arg)
+
+    args.append('-E')
+    if depfile:
+        args += ['-MT', output]
+
+    return subprocess.run(args, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+
+
+def cache_key(command, flags, output, source):
+    """Hashes everything that decides what the object looks like.
+    """
+    digest = hashlib.sha1()
+
+    compiler = shutil.which(command[0]) or command[0]
+    stat = os.stat(compiler)
+    digest.update(f'{os.path.realpath(compiler)}\0{stat.st_size}\0{stat.st_mtime_ns}\0'.encode())
+
+    for flag in flags:
+        digest.update(flag.replace(output[:-2], '\1').encode() + b'\0')
+
+    for line in source.splitlines():
+        if line.strip() and not line.startswith(b'# '):
+            digest.update(line + b'\n')
+
+    return digest.hexdigest()
+
+
+def record(cache_dir, result, seconds):
+    with open(os.path.join(cache_dir, 'stats.log'), 'a') as stats:
+        stats.write(f'{result} {seconds:.4f}\n')
+
+
+def store(entry, output, log, seconds):
+    """Adds an object to the cache. Whatever is in the cache is always complete, as the metadata is written last.
+    """
+    os.makedirs(os.path.dirname(entry), exist_ok=True)
+
+    with open(output, 'rb') as obj, NamedTemporaryFile(dir=os.path.dirname(entry), delete=False) as fd:
+        shutil.copyfileobj(obj, fd)
+    os.replace(fd.name, entry + '.o')
+
+    with NamedTemporaryFile('w', dir=os.path.dirname(entry), delete=False) as fd:
+        json.dump({'log': log, 'seconds': seconds}, fd)
+    os.replace(fd.name, entry + '.json')
+
+
+def main(cache_dir, command):
+    start = time.perf_counter()
+    flags, output, depfile = parse_command(command)
+
+    preprocessed = preprocess(command, output, depfile) if output else None
+    if not preprocessed or preprocessed.returncode:
+        # Let the compiler explain what is wrong
+        return subprocess.run(command).returncode
+
+    key = cache_key(command, flags, output, preprocessed.stdout)
+    entry = os.path.join(cache_dir, key[:2], key)
+
+    try:
+        with open(entry + '.json') as fd:
+            metadata = json.load(fd)
+        shutil.copyfile(entry + '.o', output)
+        os.utime(entry + '.json')
+        sys.stderr.write(metadata['log'])
+
+        spent = time.perf_counter() - start
+        record(cache_dir, 'hit', max(metadata['seconds'] - spent, 0))
+        return 0
+
+    except (OSError, ValueError, KeyError):
+        pass
+
+    hashed = time.perf_counter()
+    compiled = subprocess.run(command, stderr=subprocess.PIPE)
+    log = compiled.stderr.decode(errors='replace')
+    sys.stderr.write(log)
+
+    if compiled.returncode == 0:
+        try:
+            store(entry, output, log, time.perf_counter() - hashed)
+        except OSError:
+            pass
+
+    record(cache_dir, 'miss', hashed - start)
+    return compiled.returncode
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 4 or sys.argv[2] != '--':
+        print(__doc__.split('\n\n')[1], file=sys.stderr)
+        sys.exit(2)
+
+    os.makedirs(sys.argv[1], exist_ok=True)
+    sys.exit(main(sys.argv[1], sys.argv[3:]))